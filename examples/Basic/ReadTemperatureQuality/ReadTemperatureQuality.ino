@@ -0,0 +1,51 @@
+/*
+  Example: ReadTemperatureQuality
+  This example shows how to use the readTemperatureQuality function. The temperature and the
+  status flags of the channel are read from the same Base Controller scan, so there is no need
+  for a separate checkBurnout call. Channels in burnout or out of range return NAN.
+
+  This example works with the P1-04THM, P1-04RTD and P1-04NTC.
+   _____  _____ 
+  |  P  ||  S  |
+  |  1  ||  L  |
+  |  A  ||  O  |
+  |  M  ||  T  |
+  |  -  ||     |
+  |  C  ||  0  |
+  |  P  ||  1  |
+  |  U  ||     |
+   ¯¯¯¯¯  ¯¯¯¯¯ 
+  Written by FACTS Engineering
+  Copyright (c) 2023 FACTS Engineering, LLC
+  Licensed under the MIT license.
+*/
+#include <P1AM.h>
+
+void setup(){ // the setup routine runs once:
+
+  Serial.begin(115200);  //initialize serial communication at 115200 bits per second 
+  while (!P1.init()){ 
+    ; //Wait for Modules to Sign on   
+  }
+}
+
+void loop(){  // the loop routine runs over and over again forever:
+  channelReading reading = P1.readTemperatureQuality(1, 1);  //Read slot 1 channel 1 with its quality flags
+
+  if(reading.quality == QUALITY_GOOD){
+    Serial.print("Temperature = ");
+    Serial.println(reading.temperature, 2);
+  }
+  else{
+    if(reading.quality & QUALITY_BURNOUT){
+      Serial.println("Channel is in burnout");
+    }
+    if(reading.quality & (QUALITY_UNDER_RANGE | QUALITY_OVER_RANGE)){
+      Serial.println("Channel is out of range");
+    }
+    if(reading.quality & QUALITY_MISSING_24V){
+      Serial.println("Module is missing 24V");
+    }
+  }
+  delay(1000);
+}
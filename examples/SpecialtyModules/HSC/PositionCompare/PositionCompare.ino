@@ -0,0 +1,61 @@
+/*
+  Example: PositionCompare
+
+  This example shows how to use the P1_HSC_Compare class to switch discrete outputs
+  when an HSC channel passes a set of positions.
+
+  This example works with the P1-02HSC and any P1000 Series Discrete Output module
+ 
+  Output 1 of the discrete output module in slot 2 turns on between 1000 and 2000 counts
+  of channel 1. Output 2 turns on above 1500 counts. Each run reads the HSC once and writes
+  all outputs once. The measured time from reading the position to writing the outputs is
+  printed whenever an output switches.
+    
+	 _____  _____  _____ 
+	|  P  ||  S  ||  S  |
+	|  1  ||  L  ||  L  |
+	|  A  ||  O  ||  O  |
+	|  M  ||  T  ||  T  |
+	|  -  ||     ||     |
+	|  C  ||  0  ||  0  |
+	|  P  ||  1  ||  2  |
+	|  U  ||     ||     |
+	 ¯¯¯¯¯  ¯¯¯¯¯  ¯¯¯¯¯ 
+	Written by FACTS Engineering
+	Copyright (c) 2023 FACTS Engineering, LLC
+	Licensed under the MIT license.
+*/
+
+#include <P1AM.h>
+#include <P1_HSC.h>
+#include <P1_Image.h>
+#include <P1_HSC_Compare.h>
+
+P1_HSC_Module HSC(1);     //HSC module in slot 1
+P1_Image image;           //Discrete outputs are written through the image
+P1_HSC_Compare compare(image);
+
+void setup(){ // the setup routine runs once:
+
+  Serial.begin(115200);  //initialize serial communication at 115200 bits per second 
+  while (!P1.init()){ 
+    ; //Wait for Modules to Sign on   
+  }
+  
+  HSC.configureChannels();  //Load default settings into HSC module
+  image.begin();
+
+  compare.hysteresis = 10;  //Position must fall 10 counts below a setpoint before the output switches back
+  compare.addSetpoint(HSC.CNT1, 1000, image.outputPoint(2, 1), HIGH); //On above 1000
+  compare.addSetpoint(HSC.CNT1, 2000, image.outputPoint(2, 1), LOW);  //Off again above 2000
+  compare.addSetpoint(HSC.CNT1, 1500, image.outputPoint(2, 2), HIGH); //On above 1500
+}
+
+void loop(){  // the loop routine runs over and over again forever:
+
+  if(compare.run() > 0){
+    Serial.print("Output switched. Latency = ");
+    Serial.print(compare.lastLatency);
+    Serial.println("us");
+  }
+}
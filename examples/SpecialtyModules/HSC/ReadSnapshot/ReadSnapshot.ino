@@ -0,0 +1,63 @@
+/*
+  Example: ReadSnapshot
+
+  This example shows how to use the readSnapshot function for an HSC module
+
+  This example works with the P1-02HSC
+ 
+  readSnapshot reads both positions, both alert registers and all 8 inputs of the
+  module in one transaction. Every value comes from the same Base Controller scan,
+  so the positions are not skewed in time from each other or from the inputs.
+    
+	 _____  _____ 
+	|  P  ||  S  |
+	|  1  ||  L  |
+	|  A  ||  O  |
+	|  M  ||  T  |
+	|  -  ||     |
+	|  C  ||  0  |
+	|  P  ||  1  |
+	|  U  ||     |
+	 ¯¯¯¯¯  ¯¯¯¯¯ 
+	Written by FACTS Engineering
+	Copyright (c) 2023 FACTS Engineering, LLC
+	Licensed under the MIT license.
+*/
+
+#include <P1AM.h>
+#include <P1_HSC.h>
+
+P1_HSC_Module HSC(1); //Create HSC class object for slot 1. It also automatically creates 2 P1_HSC_CHANNEL objects for this slot
+
+void setup(){ // the setup routine runs once:
+
+  Serial.begin(115200);  //initialize serial communication at 115200 bits per second 
+  while (!Serial){
+    ; //Wait for Serial Port to be opened
+  }
+  
+  while (!P1.init()){ 
+    ; //Wait for Modules to Sign on   
+  }
+  
+  HSC.configureChannels();  //Load default settings into HSC module
+}
+
+void loop(){  // the loop routine runs over and over again forever:
+
+ hscSnapshot reading = HSC.readSnapshot(); //Read everything at once
+
+ Serial.print("Scan ");
+ Serial.print(reading.scanSequence);
+ Serial.print(" at ");
+ Serial.print(reading.timestamp);
+ Serial.println("us");
+ Serial.print("Channel 1 Position = ");
+ Serial.println(reading.position1);
+ Serial.print("Channel 2 Position = ");
+ Serial.println(reading.position2);
+ Serial.print("Inputs = ");
+ Serial.println(reading.inputs, BIN);
+
+ delay(1000);  
+}
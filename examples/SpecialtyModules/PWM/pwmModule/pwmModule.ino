@@ -0,0 +1,61 @@
+/*
+  Example: pwmModule
+
+  This example shows how to use the P1_PWM_Module class to update all channels of a
+  P1-04PWM at once. The duty cycle and frequency of each channel are staged with set,
+  setDuty and setFreq, then sent together by update in one block write. Channels that
+  have not changed since the last update are not sent.
+
+  Channel 1 sweeps its duty cycle from 0 to 100 percent while channels 2-4 stay at
+  fixed values. After the first update only channel 1 is sent.
+ 
+  This example works with the P1-04PWM in slot 1.
+	 _____  _____ 
+	|  P  ||  S  |
+	|  1  ||  L  |
+	|  A  ||  O  |
+	|  M  ||  T  |
+	|  -  ||     |
+	|  C  ||  0  |
+	|  P  ||  1  |
+	|  U  ||     |
+	 ¯¯¯¯¯  ¯¯¯¯¯ 
+	Written by FACTS Engineering
+	Copyright (c) 2023 FACTS Engineering, LLC
+	Licensed under the MIT license.
+ */
+
+
+#include <P1AM.h>
+#include <P1_PWM.h>
+
+P1_PWM_Module PWM(1); //PWM module in slot 1
+
+void setup() {  // the setup routine runs once:
+  Serial.begin(115200);   //initialize serial communication at 115200 bits per second 
+  while(!P1.init())
+  {
+    ; //wait for Modules to sign on
+  }
+
+  PWM.set(2, 25.00, 1000);  //Channel, duty cycle, frequency
+  PWM.set(3, 50.00, 2000);
+  PWM.set(4, 75.00, 4000);
+}
+
+float dutyCycle = 0;
+
+void loop() { // the loop routine runs over and over again forever:
+  
+  PWM.set(1, dutyCycle, 10000);
+  uint8_t sent = PWM.update();  //Send every changed channel in one write
+
+  Serial.print("Channels sent = ");
+  Serial.println(sent);
+
+  dutyCycle += 10;
+  if(dutyCycle > 100){
+    dutyCycle = 0;
+  }
+  delay(1000);
+}
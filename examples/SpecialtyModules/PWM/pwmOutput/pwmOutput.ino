@@ -51,6 +51,7 @@ void loop() { // the loop routine runs over and over again forever:
   P1.writePWM(dutyCycle, frequency, 1, 2);  //The values to be passed in are duty cycle, frequency, slot, channel
   //P1.writePWMDuty(dutyCycle, 1, 2); //writePWMDuty can be used to change only the dutycycle
   //P1.writePWMFreq(frequency, 1, 2); //writePWMFreq can be used to change only the frequency
+  //P1.writePWMFixed(5015, frequency, 1, 2); //writePWMFixed takes duty cycle in hundredths of a percent and avoids floating point math
 
   delay(5000);  //waits 5 seconds
 }
@@ -0,0 +1,78 @@
+/*
+  Example: pwmRamp
+
+  This example shows how to use the P1_PWM_Profile class to ramp the duty cycle and
+  frequency of a P1-04PWM. Profiles are stepped at a fixed update period no matter
+  how fast loop() runs, and a channel is only written when it has fallen more than
+  the tolerance behind its profile. Channels due at the same time share one write.
+
+  Channel 1 ramps up and down over 2 seconds with an S-curve. Channel 2 ramps at a
+  fixed rate of 20 percent per second. Each time channel 1 finishes a ramp, the
+  number of bus writes saved compared with writing every loop is printed.
+ 
+  This example works with the P1-04PWM in slot 1.
+	 _____  _____ 
+	|  P  ||  S  |
+	|  1  ||  L  |
+	|  A  ||  O  |
+	|  M  ||  T  |
+	|  -  ||     |
+	|  C  ||  0  |
+	|  P  ||  1  |
+	|  U  ||     |
+	 ¯¯¯¯¯  ¯¯¯¯¯ 
+	Written by FACTS Engineering
+	Copyright (c) 2023 FACTS Engineering, LLC
+	Licensed under the MIT license.
+ */
+
+
+#include <P1AM.h>
+#include <P1_PWM.h>
+
+P1_PWM_Module PWM(1);       //PWM module in slot 1
+P1_PWM_Profile Ramp(PWM);   //Profile generator for the module
+
+bool rampUp = true;
+bool rateUp = true;
+
+void setup() {  // the setup routine runs once:
+  Serial.begin(115200);   //initialize serial communication at 115200 bits per second 
+  while(!P1.init())
+  {
+    ; //wait for Modules to sign on
+  }
+
+  Ramp.updatePeriod = 10;     //Step every 10ms
+  Ramp.dutyTolerance = 25;    //Allow 0.25% error before writing
+  Ramp.freqTolerance = 50;    //Allow 50Hz error before writing
+
+  PWM.set(1, 0, 1000);
+  PWM.set(2, 0, 5000);
+  PWM.update();
+}
+
+void loop() { // the loop routine runs over and over again forever:
+  
+  if(!Ramp.isRamping(1)){
+    if(rampUp){
+      Ramp.rampTo(1, 100.00, 5000, 2000, PWM_RAMP_SCURVE);  //Channel, duty, frequency, time in ms, shape
+    }
+    else{
+      Ramp.rampTo(1, 0.00, 1000, 2000, PWM_RAMP_SCURVE);
+    }
+    rampUp = !rampUp;
+
+    Serial.print("Bus writes = ");
+    Serial.print(Ramp.busWrites);
+    Serial.print(" Writes saved = ");
+    Serial.println(Ramp.writesSaved());
+  }
+
+  if(!Ramp.isRamping(2)){
+    Ramp.rampRate(2, rateUp ? 100.00 : 0.00, 5000, 20.0);  //Channel, duty, frequency, percent per second
+    rateUp = !rateUp;
+  }
+
+  Ramp.run();
+}
@@ -0,0 +1,117 @@
+/*
+  Example: BlockKernelBenchmark
+  This example shows how to use the block kernels to convert analog block data and measures
+  how fast they are. Analog block data is one big endian 32 bit register per channel, so each
+  channel needs its bytes reversed before it can be used. decodeAnalogBlock, 
+  decodeTemperatureBlock and encodeAnalogBlock do this for a whole region at once, one word
+  and one byte swap per channel.
+
+  The first part reads the analog inputs of the base with one block read and decodes them.
+  The second part times the kernels against the byte-at-a-time shift and OR loop used in
+  the BlockTransferAnalog example, using the largest analog block a base can have. The
+  kernels run from RAM, so the benchmark also runs with no analog modules in the base.
+
+  This example works with all P1000 Series Analog Modules.
+   _____  _____ 
+  |  P  ||  S  |
+  |  1  ||  L  |
+  |  A  ||  O  |
+  |  M  ||  T  |
+  |  -  ||     |
+  |  C  ||  0  |
+  |  P  ||  1  |
+  |  U  ||     |
+   ¯¯¯¯¯  ¯¯¯¯¯ 
+  Written by FACTS Engineering
+  Copyright (c) 2023 FACTS Engineering, LLC
+  Licensed under the MIT license.
+*/
+#include <P1AM.h>
+
+#define CHANNELS    135    //15 slots of 9 channels
+#define ITERATIONS  1000
+
+uint32_t blockWords[CHANNELS];               //Word aligned storage for block data
+uint8_t *block = (uint8_t *)blockWords;
+int32_t counts[CHANNELS];
+float temperatures[CHANNELS];
+
+void setup(){ // the setup routine runs once:
+
+  Serial.begin(115200);  //initialize serial communication at 115200 bits per second 
+  while (!P1.init()){ 
+    ; //Wait for Modules to Sign on   
+  }
+}
+
+void printRate(const char *name, uint32_t elapsed){
+  Serial.print(name);
+  Serial.print(": ");
+  Serial.print(elapsed / (float)ITERATIONS);
+  Serial.print("us per block, ");
+  Serial.print(((float)CHANNELS * ITERATIONS) / elapsed, 2);
+  Serial.println(" channels per us");
+}
+
+void loop(){  // the loop routine runs over and over again forever:
+  uint32_t start;
+  uint16_t aiBytes = 0;
+
+  /*Decode the analog inputs of the base*/
+  for(int slot = 1; slot <= NUMBER_OF_MODULES; slot++){
+    aiBytes += P1.readSlotProps(slot).aiBytes;
+  }
+  if(aiBytes > 0){
+    P1.readBlockData((char *)block, aiBytes, 0, ANALOG_IN_BLOCK);
+    decodeAnalogBlock(block, counts, aiBytes / 4);
+    for(int i = 0; i < aiBytes / 4; i++){
+      Serial.print("Analog Input Channel ");
+      Serial.print(i + 1);
+      Serial.print(" = ");
+      Serial.println(counts[i]);
+    }
+  }
+
+  /*Benchmark*/
+  for(int i = 0; i < CHANNELS * 4; i++){
+    block[i] = i;
+  }
+
+  start = micros();
+  for(int n = 0; n < ITERATIONS; n++){
+    for(int i = 0; i < CHANNELS; i++){
+      counts[i]  = (uint32_t)block[4*i + 0] << 24;
+      counts[i] |= (uint32_t)block[4*i + 1] << 16;
+      counts[i] |= (uint32_t)block[4*i + 2] << 8;
+      counts[i] |= (uint32_t)block[4*i + 3];
+    }
+  }
+  printRate("Shift and OR loop", micros() - start);
+
+  start = micros();
+  for(int n = 0; n < ITERATIONS; n++){
+    decodeAnalogBlock(block, counts, CHANNELS);
+  }
+  printRate("decodeAnalogBlock", micros() - start);
+
+  start = micros();
+  for(int n = 0; n < ITERATIONS; n++){
+    decodeAnalogBlock(block + 1, counts, CHANNELS - 1);  //Unaligned data takes the slower path
+  }
+  printRate("decodeAnalogBlock unaligned", micros() - start);
+
+  start = micros();
+  for(int n = 0; n < ITERATIONS; n++){
+    decodeTemperatureBlock(block, temperatures, CHANNELS);
+  }
+  printRate("decodeTemperatureBlock", micros() - start);
+
+  start = micros();
+  for(int n = 0; n < ITERATIONS; n++){
+    encodeAnalogBlock(counts, block, CHANNELS);
+  }
+  printRate("encodeAnalogBlock", micros() - start);
+
+  Serial.println("");
+  delay(10000);
+}
@@ -0,0 +1,60 @@
+/*
+  Example: BlockSnapshot
+  This example shows how to use the readBlockSnapshot function to read several Base Controller
+  data blocks as one coherent snapshot. Reading the analog input data and the status data with
+  two separate readBlockData calls can mix values from different Base Controller scans. A snapshot
+  reads every region inside the same scan and returns the scan sequence number it came from.
+
+  This example reads the analog input and status bytes of an analog module in slot 1 and prints
+  the first channel along with its burnout status byte and the scan sequence number.
+
+  This example works with all P1000 Series analog input modules that have status bytes.
+   _____  _____ 
+  |  P  ||  S  |
+  |  1  ||  L  |
+  |  A  ||  O  |
+  |  M  ||  T  |
+  |  -  ||     |
+  |  C  ||  0  |
+  |  P  ||  1  |
+  |  U  ||     |
+   ¯¯¯¯¯  ¯¯¯¯¯ 
+  Written by FACTS Engineering
+  Copyright (c) 2023 FACTS Engineering, LLC
+  Licensed under the MIT license.
+*/
+#include <P1AM.h>
+
+char analogIn[16];  //4 channels, 4 bytes per channel
+char statusIn[12];  //12 status bytes
+
+blockRegion regions[] = {
+  {analogIn, 16, 0, ANALOG_IN_BLOCK},
+  {statusIn, 12, 0, STATUS_IN_BLOCK}
+};
+
+void setup(){ // the setup routine runs once:
+
+  Serial.begin(115200);  //initialize serial communication at 115200 bits per second 
+  while (!P1.init()){ 
+    ; //Wait for Modules to Sign on   
+  }
+}
+
+void loop(){  // the loop routine runs over and over again forever:
+  uint32_t sequence = P1.readBlockSnapshot(regions, 2);  //Read both regions from the same scan
+
+  if(sequence == 0){
+    Serial.println("Could not take a coherent snapshot");
+  }
+  else{
+    uint32_t counts = ((uint32_t)analogIn[0] << 24) | ((uint32_t)analogIn[1] << 16) | ((uint32_t)analogIn[2] << 8) | analogIn[3];
+    Serial.print("Scan ");
+    Serial.print(sequence);
+    Serial.print(": Channel 1 = ");
+    Serial.print(counts);
+    Serial.print(" Burnout status = ");
+    Serial.println(statusIn[BURNOUT_STATUS], HEX);
+  }
+  delay(1000);
+}
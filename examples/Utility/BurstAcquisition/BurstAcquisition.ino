@@ -0,0 +1,71 @@
+/*
+  Example: BurstAcquisition
+  This example shows how to use readAnalogBurst to capture a short burst of an analog
+  channel as fast as the bus allows, e.g. to look at a transient after a valve closes.
+  The slot and channels are checked once and the samples are read back to back with no
+  scan sync in between. Each sample is stamped with micros().
+
+  The Base Controller updates its data once per scan. The result reports the achieved
+  sample rate and the measured scan period, plus how many samples repeated the scan before
+  them and how many scans were skipped. If most samples are repeats, the burst is faster
+  than the base and the data will look like a staircase.
+
+  This example works with a P1-04AD or any other analog input module in slot 1.
+   _____  _____ 
+  |  P  ||  S  |
+  |  1  ||  L  |
+  |  A  ||  O  |
+  |  M  ||  T  |
+  |  -  ||     |
+  |  C  ||  0  |
+  |  P  ||  1  |
+  |  U  ||     |
+   ¯¯¯¯¯  ¯¯¯¯¯ 
+  Written by FACTS Engineering
+  Copyright (c) 2023 FACTS Engineering, LLC
+  Licensed under the MIT license.
+*/
+#include <P1AM.h>
+
+const uint16_t SAMPLES = 200;
+const uint8_t CHANNELS = 2;
+
+uint8_t burst[SAMPLES * CHANNELS * 4];  //4 bytes per channel per sample
+uint32_t timestamps[SAMPLES];
+
+void setup(){ // the setup routine runs once:
+
+  Serial.begin(115200);  //initialize serial communication at 115200 bits per second 
+  while (!P1.init()){ 
+    ; //Wait for Modules to Sign on   
+  }
+}
+
+void loop(){  // the loop routine runs over and over again forever:
+  int32_t counts[CHANNELS];
+  burstStats result;
+
+  result = P1.readAnalogBurst((char *)burst, timestamps, SAMPLES, 1, 1, CHANNELS);  //Buffer, timestamps, samples, slot, first channel, channels
+
+  Serial.print("Samples: ");
+  Serial.print(result.samples);
+  Serial.print(" Rate: ");
+  Serial.print(result.rate);
+  Serial.print("/s Scan period: ");
+  Serial.print(result.scanPeriod);
+  Serial.print("us Repeated: ");
+  Serial.print(result.repeatedScans);
+  Serial.print(" Skipped: ");
+  Serial.println(result.skippedScans);
+
+  for(int i = 0; i < result.samples; i++){
+    decodeAnalogBlock(&burst[i * CHANNELS * 4], counts, CHANNELS);  //Convert one sample to counts
+    Serial.print(timestamps[i] - timestamps[0]);
+    Serial.print("us ");
+    Serial.print(counts[0]);
+    Serial.print(" ");
+    Serial.println(counts[1]);
+  }
+
+  delay(5000);
+}
@@ -0,0 +1,82 @@
+/*
+  Example: ChannelStatistics
+  This example shows how to use the P1_Statistics class to keep the min, max, mean and
+  variance of analog channels for condition monitoring. Each scan of the analog image adds
+  one sample per channel with a fixed amount of work. Reading the statistics causes no bus
+  traffic.
+
+  Channels can be given a window length in samples. When a window fills, its statistics are
+  saved and a new window starts. windowDone returns true once for each finished window.
+
+  Slot 1 channel 1 is a vibration sensor summarized every 1000 samples. Slot 2 channel 1 is
+  a bearing temperature summarized over the whole run until input 1 of slot 3 is pressed.
+
+  This example works with a P1-04AD in slot 1, a P1-04THM or P1-04RTD in slot 2 and a discrete
+  input module in slot 3.
+   _____  _____  _____  _____ 
+  |  P  ||  S  ||  S  ||  S  |
+  |  1  ||  L  ||  L  ||  L  |
+  |  A  ||  O  ||  O  ||  O  |
+  |  M  ||  T  ||  T  ||  T  |
+  |  -  ||     ||     ||     |
+  |  C  ||  0  ||  0  ||  0  |
+  |  P  ||  1  ||  2  ||  3  |
+  |  U  ||     ||     ||     |
+   ¯¯¯¯¯  ¯¯¯¯¯  ¯¯¯¯¯  ¯¯¯¯¯ 
+  Written by FACTS Engineering
+  Copyright (c) 2023 FACTS Engineering, LLC
+  Licensed under the MIT license.
+*/
+#include <P1AM.h>
+#include <P1_Statistics.h>
+
+P1_Scan scan;               //Image of every input in the base
+P1_Statistics stats(scan);  //Statistics fed from the image
+
+int8_t vibration;
+int8_t bearing;
+P1_DiscreteChannel resetButton;
+
+void printStats(const char *name, channelStats s){
+  Serial.print(name);
+  Serial.print(" samples: ");
+  Serial.print(s.samples);
+  Serial.print(" min: ");
+  Serial.print(s.min);
+  Serial.print(" max: ");
+  Serial.print(s.max);
+  Serial.print(" mean: ");
+  Serial.print(s.mean);
+  Serial.print(" std dev: ");
+  Serial.println(sqrt(s.variance));
+}
+
+void setup(){ // the setup routine runs once:
+
+  Serial.begin(115200);  //initialize serial communication at 115200 bits per second 
+  while (!P1.init()){ 
+    ; //Wait for Modules to Sign on   
+  }
+  scan.begin();
+
+  vibration = stats.addChannel(1, 1, 1000);  //Slot, channel, samples per window
+  bearing = stats.addChannel(2, 1);          //Slot, channel. One window until reset
+  resetButton = scan.discreteChannel(3, 1);
+}
+
+void loop(){  // the loop routine runs over and over again forever:
+  scan.update();   //Read every input in the base
+  stats.update();  //Add this scan to the statistics
+
+  if(stats.windowDone(vibration)){
+    printStats("Vibration", stats.readWindow(vibration));
+  }
+
+  if(resetButton.read()){
+    stats.reset(bearing);
+    printStats("Bearing", stats.readWindow(bearing));
+    while(resetButton.read()){
+      scan.update();  //Wait for the button to be released
+    }
+  }
+}
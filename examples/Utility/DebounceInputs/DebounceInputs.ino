@@ -0,0 +1,64 @@
+/*
+  Example: DebounceInputs
+  This example shows how to use the P1_Debounce class to filter contact bounce on every
+  discrete input in the base. An input only changes state once it has held its new state
+  for its filter time, counted in scans. On and off times can be set for each point.
+
+  The filtering uses vertical counters, so debouncing all the inputs in a base takes a few
+  word operations per scan no matter how many points there are.
+
+  Every input gets a 3 scan filter. Input 1 of slot 1, a pushbutton, gets a longer 8 scan
+  on time and 4 scan off time. With the 5ms loop below, that is 40ms to turn on and 20ms
+  to turn off. The debounced state of the button is shown on output 1 of slot 2.
+
+  This example works with a P1-08ND3 or P1-16ND3 in slot 1 and a discrete output module in slot 2.
+   _____  _____  _____ 
+  |  P  ||  S  ||  S  |
+  |  1  ||  L  ||  L  |
+  |  A  ||  O  ||  O  |
+  |  M  ||  T  ||  T  |
+  |  -  ||     ||     |
+  |  C  ||  0  ||  0  |
+  |  P  ||  1  ||  2  |
+  |  U  ||     ||     |
+   ¯¯¯¯¯  ¯¯¯¯¯  ¯¯¯¯¯ 
+  Written by FACTS Engineering
+  Copyright (c) 2023 FACTS Engineering, LLC
+  Licensed under the MIT license.
+*/
+#include <P1AM.h>
+#include <P1_Debounce.h>
+
+P1_Image image;               //Packed image of every discrete point in the base
+P1_Debounce debounce(image);  //Debounced copy of the inputs
+
+uint16_t button;
+uint16_t light;
+
+void setup(){ // the setup routine runs once:
+
+  Serial.begin(115200);  //initialize serial communication at 115200 bits per second 
+  while (!P1.init()){ 
+    ; //Wait for Modules to Sign on   
+  }
+  image.begin();
+
+  button = image.inputPoint(1, 1);   //Slot, channel
+  light = image.outputPoint(2, 1);
+
+  debounce.setFilter(3, 3);          //On scans, off scans for every input
+  debounce.setFilter(button, 8, 4);  //Point, on scans, off scans
+}
+
+void loop(){  // the loop routine runs over and over again forever:
+  image.update();     //Read every discrete input in the base
+  debounce.update();  //Debounce them all
+
+  if(debounce.readInput(button) != image.readOutput(light)){
+    Serial.println(debounce.readInput(button) ? "Button pressed" : "Button released");
+  }
+  image.writeOutput(light, debounce.readInput(button));
+
+  image.flush();
+  delay(5);
+}
@@ -0,0 +1,53 @@
+/*
+  Example: DiscreteImage
+  This example shows how to use the P1_Image class to work with every discrete point in the
+  base at once. update() reads all discrete inputs with one block read and flush() writes all
+  discrete outputs with one block write. In between, the inputs and outputs are plain 32-bit
+  words so interlock logic can be written as bitwise operations.
+
+  Points are numbered in slot order starting at 0. Use inputPoint and outputPoint to find the
+  point number of a slot and channel.
+
+  This example mirrors the first 8 discrete inputs in the base onto the first 8 discrete outputs
+  and toggles output point 8 every loop.
+
+  This example works with all P1000 Series Discrete Input and Output Modules.
+   _____  _____  _____ 
+  |  P  ||  S  ||  S  |
+  |  1  ||  L  ||  L  |
+  |  A  ||  O  ||  O  |
+  |  M  ||  T  ||  T  |
+  |  -  ||     ||     |
+  |  C  ||  0  ||  0  |
+  |  P  ||  1  ||  2  |
+  |  U  ||     ||     |
+   ¯¯¯¯¯  ¯¯¯¯¯  ¯¯¯¯¯ 
+  Written by FACTS Engineering
+  Copyright (c) 2023 FACTS Engineering, LLC
+  Licensed under the MIT license.
+*/
+#include <P1AM.h>
+#include <P1_Image.h>
+
+P1_Image image;  //Packed image of every discrete point in the base
+
+void setup(){ // the setup routine runs once:
+
+  Serial.begin(115200);  //initialize serial communication at 115200 bits per second 
+  while (!P1.init()){ 
+    ; //Wait for Modules to Sign on   
+  }
+  image.begin();  //Size the image from the modules that signed on
+}
+
+void loop(){  // the loop routine runs over and over again forever:
+  image.update();  //Read every discrete input in the base
+
+  uint32_t mirrored = image.inputs[0] & 0xFF;
+  image.clearOutputs(0, ~mirrored & 0xFF);  //Clear outputs whose input is off
+  image.setOutputs(0, mirrored);            //Set outputs whose input is on
+  image.toggleOutputs(0, 1UL << 8);         //Toggle output point 8
+
+  image.flush();  //Write every discrete output in the base
+  delay(500);
+}
@@ -0,0 +1,73 @@
+/*
+  Example: FilteredAnalog
+  This example shows how to use the P1_Filter class to smooth noisy analog inputs. Each
+  filter takes one sample from every scan of the analog image, so there is no need to call
+  readAnalog several times and average the results.
+
+  Four filters are available:
+   - FILTER_IIR: First order low pass. The setting is the time constant as a power of 2
+     scans, so 3 responds like an average of about 8 scans.
+   - FILTER_AVERAGE: Moving average of up to 16 samples.
+   - FILTER_MEDIAN: Median of up to 16 samples. Removes single scan spikes.
+   - FILTER_RATE: Limits how many counts the value may change per scan.
+
+  This example runs all four filters on channel 1 of slot 1 and prints them next to the
+  raw value.
+
+  This example works with all P1000 Series analog input modules in slot 1.
+   _____  _____ 
+  |  P  ||  S  |
+  |  1  ||  L  |
+  |  A  ||  O  |
+  |  M  ||  T  |
+  |  -  ||     |
+  |  C  ||  0  |
+  |  P  ||  1  |
+  |  U  ||     |
+   ¯¯¯¯¯  ¯¯¯¯¯ 
+  Written by FACTS Engineering
+  Copyright (c) 2023 FACTS Engineering, LLC
+  Licensed under the MIT license.
+*/
+#include <P1AM.h>
+#include <P1_Filter.h>
+
+P1_Scan scan;            //Analog image of the base
+P1_Filter filters(scan); //Filters fed from the image
+
+int8_t lowPass;
+int8_t average;
+int8_t median;
+int8_t rateLimit;
+
+void setup(){ // the setup routine runs once:
+
+  Serial.begin(115200);  //initialize serial communication at 115200 bits per second 
+  while (!P1.init()){ 
+    ; //Wait for Modules to Sign on   
+  }
+  scan.begin();
+
+  lowPass = filters.addFilter(1, 1, FILTER_IIR, 3);        //Slot, channel, type, setting
+  average = filters.addFilter(1, 1, FILTER_AVERAGE, 8);
+  median = filters.addFilter(1, 1, FILTER_MEDIAN, 5);
+  rateLimit = filters.addFilter(1, 1, FILTER_RATE, 50);
+}
+
+void loop(){  // the loop routine runs over and over again forever:
+  scan.update();     //Read every input in the base
+  filters.update();  //Add the new scan to every filter
+
+  Serial.print("Raw: ");
+  Serial.print(filters.readRaw(lowPass));
+  Serial.print(" IIR: ");
+  Serial.print(filters.read(lowPass));
+  Serial.print(" Average: ");
+  Serial.print(filters.read(average));
+  Serial.print(" Median: ");
+  Serial.print(filters.read(median));
+  Serial.print(" Rate: ");
+  Serial.println(filters.read(rateLimit));
+
+  delay(50);
+}
@@ -0,0 +1,74 @@
+/*
+  Example: LinearizedSensor
+  This example shows how to convert a non-linear sensor to engineering units with a
+  piecewise linear table. The table is a list of breakpoints, each a raw count and the value
+  it stands for. Readings between two breakpoints are interpolated in integer math.
+
+  Tables are declared constexpr and given to the LINEARIZATION macro, which stops the sketch
+  from compiling if the raw counts do not increase from one point to the next. Tables with
+  points evenly spaced by a power of 2, like volumeTable below, are looked up with a single
+  shift instead of a search.
+
+  Slot 1 channel 1 is a level probe in a horizontal cylindrical tank, read straight with
+  readAnalog. Slot 1 channel 2 is a pressure transducer with a non-linear low end, read
+  through the P1_Scan and P1_Scaling path with a calibration offset.
+
+  This example works with a P1-04AD in slot 1.
+   _____  _____ 
+  |  P  ||  S  |
+  |  1  ||  L  |
+  |  A  ||  O  |
+  |  M  ||  T  |
+  |  -  ||     |
+  |  C  ||  0  |
+  |  P  ||  1  |
+  |  U  ||     |
+   ¯¯¯¯¯  ¯¯¯¯¯ 
+  Written by FACTS Engineering
+  Copyright (c) 2023 FACTS Engineering, LLC
+  Licensed under the MIT license.
+*/
+#include <P1AM.h>
+#include <P1_Scale.h>
+
+constexpr linearPoint volumeTable[] = {  //Counts, gallons. Evenly spaced every 8192 counts
+  {0, 0}, {8192, 52}, {16384, 143}, {24576, 254}, {32768, 375},
+  {40960, 496}, {49152, 607}, {57344, 698}, {65536, 750}
+};
+
+constexpr linearPoint pressureTable[] = {  //Counts, hundredths of a PSI
+  {0, 0}, {2000, 150}, {6000, 900}, {20000, 4000}, {65535, 15000}
+};
+
+LINEARIZATION(tankVolume, volumeTable);
+LINEARIZATION(pressureCurve, pressureTable);
+
+P1_Scan scan;
+P1_Scaling scaling(scan);
+int8_t pressure;
+
+void setup(){ // the setup routine runs once:
+
+  Serial.begin(115200);  //initialize serial communication at 115200 bits per second 
+  while (!P1.init()){ 
+    ; //Wait for Modules to Sign on   
+  }
+  scan.begin();
+  pressure = scaling.addInput(1, 2, pressureCurve);  //Slot, channel, table
+  scaling.calibrate(pressure, 1.0, -12);             //Remove a 0.12 PSI offset
+}
+
+void loop(){  // the loop routine runs over and over again forever:
+
+  Serial.print("Tank volume: ");
+  Serial.print(tankVolume.readAnalog(1, 1));  //Slot, channel
+  Serial.println(" gallons");
+
+  scan.update();
+  scaling.update();
+  Serial.print("Pressure: ");
+  Serial.print(scaling.read(pressure) / 100.0, 2);
+  Serial.println(" PSI");
+
+  delay(1000);
+}
@@ -0,0 +1,78 @@
+/*
+  Example: ModuleDrivers
+  This example shows how to use the P1_Scan class. When begin() is called each slot gets a
+  driver for its module family: discrete, analog, temperature, PWM or high speed counter.
+  update() reads every input in the base in one snapshot and each driver decodes its own slot.
+  flush() lets each driver encode the outputs that changed and sends them in as few block
+  writes as possible.
+
+  Channels are used through typed handles that are checked once when they are created. A
+  handle for the wrong kind of module is not valid and does nothing.
+
+  This example copies input 1 of the combo module in slot 1 to its output 1, prints analog
+  channel 1 of slot 2 and temperature channel 1 of slot 3, and sets analog output 1 of
+  slot 2 to follow the temperature.
+
+  This example works with a P1-16CDR in slot 1, a P1-4ADL2DAL-1 in slot 2 and a P1-04THM
+  in slot 3.
+   _____  _____  _____  _____ 
+  |  P  ||  S  ||  S  ||  S  |
+  |  1  ||  L  ||  L  ||  L  |
+  |  A  ||  O  ||  O  ||  O  |
+  |  M  ||  T  ||  T  ||  T  |
+  |  -  ||     ||     ||     |
+  |  C  ||  0  ||  0  ||  0  |
+  |  P  ||  1  ||  2  ||  3  |
+  |  U  ||     ||     ||     |
+   ¯¯¯¯¯  ¯¯¯¯¯  ¯¯¯¯¯  ¯¯¯¯¯ 
+  Written by FACTS Engineering
+  Copyright (c) 2023 FACTS Engineering, LLC
+  Licensed under the MIT license.
+*/
+#include <P1AM.h>
+#include <P1_Scan.h>
+
+P1_Scan scan;  //Drivers and decoded data for every slot
+
+P1_DiscreteChannel input1;
+P1_DiscreteChannel output1;
+P1_AnalogChannel analogIn1;
+P1_AnalogChannel analogOut1;
+P1_TemperatureChannel temperature1;
+
+void setup(){ // the setup routine runs once:
+
+  Serial.begin(115200);  //initialize serial communication at 115200 bits per second 
+  while (!P1.init()){ 
+    ; //Wait for Modules to Sign on   
+  }
+  scan.begin();  //Give each slot a driver
+
+  input1 = scan.discreteChannel(1, 1);  //Slot, channel
+  output1 = scan.discreteChannel(1, 1);
+  analogIn1 = scan.analogChannel(2, 1);
+  analogOut1 = scan.analogChannel(2, 1);
+  temperature1 = scan.temperatureChannel(3, 1);
+
+  if(!temperature1.valid()){
+    Serial.println("Slot 3 is not a temperature module");
+  }
+}
+
+void loop(){  // the loop routine runs over and over again forever:
+  scan.update();  //Read and decode every input in the base
+
+  output1.write(input1.read());
+
+  Serial.print("Analog counts: ");
+  Serial.print(analogIn1.read());
+  Serial.print(" Temperature: ");
+  Serial.println(temperature1.read());  //NAN if the channel has a fault
+
+  if(temperature1.quality() == QUALITY_GOOD){
+    analogOut1.write((uint32_t)(temperature1.read() * 10));  //0.1 degree per count
+  }
+
+  scan.flush();  //Write the outputs that changed
+  delay(500);
+}
@@ -0,0 +1,87 @@
+/*
+  Example: PIDLoop
+  This example shows how to use the P1_PID class to run PID loops in step with the I/O scan.
+  The library samples each loop on a fixed time grid taken from the scan, so the sample time
+  does not change with whatever else loop() does. The math is fixed point and the outputs are
+  sent with the rest of the base on scan.flush().
+
+  Loop 1 holds a tank level measured on slot 1 channel 1 by driving a valve on slot 2
+  channel 1. Loop 2 holds a temperature transmitter on slot 1 channel 2 by driving a heater
+  with the duty cycle of slot 3 channel 1. Input 1 of slot 4 switches both loops between
+  manual and auto. Switching is bumpless in both directions.
+
+  This example works with a P1-04AD in slot 1, a P1-04DAL-1 in slot 2, a P1-04PWM in slot 3
+  and a discrete input module in slot 4.
+   _____  _____  _____  _____  _____ 
+  |  P  ||  S  ||  S  ||  S  ||  S  |
+  |  1  ||  L  ||  L  ||  L  ||  L  |
+  |  A  ||  O  ||  O  ||  O  ||  O  |
+  |  M  ||  T  ||  T  ||  T  ||  T  |
+  |  -  ||     ||     ||     ||     |
+  |  C  ||  0  ||  0  ||  0  ||  0  |
+  |  P  ||  1  ||  2  ||  3  ||  4  |
+  |  U  ||     ||     ||     ||     |
+   ¯¯¯¯¯  ¯¯¯¯¯  ¯¯¯¯¯  ¯¯¯¯¯  ¯¯¯¯¯ 
+  Written by FACTS Engineering
+  Copyright (c) 2023 FACTS Engineering, LLC
+  Licensed under the MIT license.
+*/
+#include <P1AM.h>
+#include <P1_PID.h>
+
+P1_Scan scan;       //Image of every input and output in the base
+P1_PID pid(scan);   //PID loops run from the image
+
+int8_t level;
+int8_t heater;
+P1_DiscreteChannel autoSwitch;
+
+void setup(){ // the setup routine runs once:
+
+  Serial.begin(115200);  //initialize serial communication at 115200 bits per second 
+  while (!P1.init()){ 
+    ; //Wait for Modules to Sign on   
+  }
+  scan.begin();
+
+  level = pid.addLoop(1, 1, 2, 1, 100);    //PV slot, channel, output slot, channel, sample time in ms
+  pid.setTuning(level, 0.5, 0.2, 0);       //Kp, Ki per second, Kd seconds
+  pid.setSetpoint(level, 32000);           //Counts of the level transmitter
+
+  heater = pid.addLoop(1, 2, 3, 1, 500);
+  pid.setTuning(heater, 2.0, 0.05, 1.0);
+  pid.setOutputLimits(heater, 0, 8000);    //Heater duty never above 80.00%
+  pid.setSetpoint(heater, 40000);
+  scan.pwmChannel(3, 1).writeFreq(1000);   //The loop only drives the duty. Set a 1kHz frequency once
+
+  autoSwitch = scan.discreteChannel(4, 1);
+}
+
+void loop(){  // the loop routine runs over and over again forever:
+  scan.update();  //Read every input in the base
+
+  if(autoSwitch.read() && !pid.isAuto(level)){
+    pid.setAuto(level);
+    pid.setAuto(heater);
+  }
+  else if(!autoSwitch.read() && pid.isAuto(level)){
+    pid.setManual(level, pid.readOutput(level));  //Hold the last output
+    pid.setManual(heater, 0);                     //Heater off in manual
+  }
+
+  pid.update();   //Run the loops that are due
+  scan.flush();   //Send the outputs
+
+  static uint32_t lastPrint = 0;
+  if(millis() - lastPrint >= 1000){
+    lastPrint = millis();
+    Serial.print("Level error: ");
+    Serial.print(pid.readError(level));
+    Serial.print(" Valve: ");
+    Serial.print(pid.readOutput(level));
+    Serial.print(" Heater error: ");
+    Serial.print(pid.readError(heater));
+    Serial.print(" Duty: ");
+    Serial.println(pid.readOutput(heater) / 100.0);
+  }
+}
@@ -0,0 +1,68 @@
+/*
+  Example: ScaledAnalog
+  This example shows how to use the P1_Scaling class to convert analog counts to engineering
+  units and back. Each channel is given a raw range and an engineering range once in setup.
+  After that every conversion is a single fixed point multiply and add, with no floating point
+  math in the loop.
+
+  Engineering values are integers, so choose a unit that gives the resolution you need. Here
+  pressure is kept in hundredths of a PSI and the output in tenths of a percent.
+
+  Slot 1 reads a 4-20mA pressure transmitter spanning 0-100.00 PSI. On the 12 bit P1-04ADL-1,
+  4mA is 819 counts and 20mA is 4095 counts. Slot 2 drives a valve from 0-100.0% open,
+  following the pressure.
+
+  This example works with a P1-04ADL-1 in slot 1 and a P1-04DAL-1 in slot 2.
+   _____  _____  _____ 
+  |  P  ||  S  ||  S  |
+  |  1  ||  L  ||  L  |
+  |  A  ||  O  ||  O  |
+  |  M  ||  T  ||  T  |
+  |  -  ||     ||     |
+  |  C  ||  0  ||  0  |
+  |  P  ||  1  ||  2  |
+  |  U  ||     ||     |
+   ¯¯¯¯¯  ¯¯¯¯¯  ¯¯¯¯¯ 
+  Written by FACTS Engineering
+  Copyright (c) 2023 FACTS Engineering, LLC
+  Licensed under the MIT license.
+*/
+#include <P1AM.h>
+#include <P1_Scale.h>
+
+P1_Scan scan;               //Analog image of the base
+P1_Scaling scaling(scan);   //Engineering unit conversion for the image
+
+int8_t pressure;
+int8_t valve;
+
+void setup(){ // the setup routine runs once:
+
+  Serial.begin(115200);  //initialize serial communication at 115200 bits per second 
+  while (!P1.init()){ 
+    ; //Wait for Modules to Sign on   
+  }
+  scan.begin();
+
+  pressure = scaling.addInput(1, 1, 819, 4095, 0, 10000);  //Slot, channel, raw low, raw high, 0.00 PSI, 100.00 PSI
+  valve = scaling.addOutput(2, 1, 0, 1000);                //Slot, channel, 0.0%, 100.0%. Raw range from module resolution
+  scaling.calibrate(pressure, 1.002, -15);                 //Gain and offset from a calibration check
+}
+
+void loop(){  // the loop routine runs over and over again forever:
+  scan.update();      //Read every input in the base
+  scaling.update();   //Convert every scaled input
+
+  int32_t psi = scaling.read(pressure);
+  Serial.print("Pressure: ");
+  Serial.print(psi / 100);
+  Serial.print(".");
+  if(psi % 100 < 10){
+    Serial.print("0");
+  }
+  Serial.println(psi % 100);
+
+  scaling.write(valve, psi / 10);  //Open the valve 1% per PSI
+  scan.flush();                    //Send the new output counts
+  delay(500);
+}
@@ -0,0 +1,73 @@
+/*
+  Example: SoftwareCounter
+  This example shows how to use the P1_Counter class to count pulses on ordinary discrete
+  inputs. Every scan, the edges of all inputs in the base are found together with a few
+  word operations, and each counter adds the edges of its point. Counters can count up or
+  down on rising edges, falling edges or both, and can be preset to any value.
+
+  A pulse has to be on for at least one scan and off for at least one scan to be counted.
+  maxRate reports the fastest pulse rate that can be counted at the longest scan period
+  seen so far. Use a P1-02HSC for anything faster.
+
+  Input 1 of slot 1 counts parts up. Input 2 counts the parts removed down from the same
+  total. Input 3 resets the total to 0.
+
+  This example works with all P1000 Series Discrete Input Modules in slot 1.
+   _____  _____ 
+  |  P  ||  S  |
+  |  1  ||  L  |
+  |  A  ||  O  |
+  |  M  ||  T  |
+  |  -  ||     |
+  |  C  ||  0  |
+  |  P  ||  1  |
+  |  U  ||     |
+   ¯¯¯¯¯  ¯¯¯¯¯ 
+  Written by FACTS Engineering
+  Copyright (c) 2023 FACTS Engineering, LLC
+  Licensed under the MIT license.
+*/
+#include <P1AM.h>
+#include <P1_Counter.h>
+
+P1_Image image;             //Packed image of every discrete point in the base
+P1_Counter counters(image); //Counters fed from the image
+
+int8_t partsIn;
+int8_t partsOut;
+uint16_t resetInput;
+uint32_t lastPrint = 0;
+
+void setup(){ // the setup routine runs once:
+
+  Serial.begin(115200);  //initialize serial communication at 115200 bits per second 
+  while (!P1.init()){ 
+    ; //Wait for Modules to Sign on   
+  }
+  image.begin();
+
+  partsIn = counters.addCounter(image.inputPoint(1, 1), COUNT_RISING);         //Point, edges
+  partsOut = counters.addCounter(image.inputPoint(1, 2), COUNT_RISING, true);  //Point, edges, count down
+  resetInput = image.inputPoint(1, 3);
+}
+
+void loop(){  // the loop routine runs over and over again forever:
+  image.update();     //Read every discrete input in the base
+  counters.update();  //Count the edges of this scan
+
+  if(image.readInput(resetInput)){
+    counters.preset(partsIn, 0);
+    counters.preset(partsOut, 0);
+  }
+
+  if(millis() - lastPrint > 1000){
+    lastPrint = millis();
+    Serial.print("Parts in tank: ");
+    Serial.print(counters.read(partsIn) + counters.read(partsOut));
+    Serial.print(" Scan period: ");
+    Serial.print(counters.scanPeriod);
+    Serial.print("us Max countable rate: ");
+    Serial.print(counters.maxRate());
+    Serial.println("Hz");
+  }
+}
@@ -0,0 +1,70 @@
+/*
+  Example: TriggeredCapture
+  This example shows how to use the P1_Capture class to catch the history around an
+  intermittent fault. Selected channels of the scan image are recorded every scan into a
+  circular history. When the capture is armed and the trigger fires, the samples before and
+  after the trigger are frozen and can be printed while recording continues.
+
+  Here the trigger is slot 1 channel 1 rising past 3000 counts. A burnout on slot 1 channel 1
+  can be used instead with setStatusTrigger. The capture keeps 20 scans before the trigger
+  and 10 after, with the pressure in slot 1 channel 1 and a limit switch on input 1 of slot 2.
+
+  This example works with a P1-04AD in slot 1 and a discrete input module in slot 2.
+   _____  _____  _____ 
+  |  P  ||  S  ||  S  |
+  |  1  ||  L  ||  L  |
+  |  A  ||  O  ||  O  |
+  |  M  ||  T  ||  T  |
+  |  -  ||     ||     |
+  |  C  ||  0  ||  0  |
+  |  P  ||  1  ||  2  |
+  |  U  ||     ||     |
+   ¯¯¯¯¯  ¯¯¯¯¯  ¯¯¯¯¯ 
+  Written by FACTS Engineering
+  Copyright (c) 2023 FACTS Engineering, LLC
+  Licensed under the MIT license.
+*/
+#include <P1AM.h>
+#include <P1_Capture.h>
+
+P1_Scan scan;               //Image of every input in the base
+P1_Capture capture(scan);   //History of selected channels
+
+int8_t pressure;
+int8_t limitSwitch;
+
+void setup(){ // the setup routine runs once:
+
+  Serial.begin(115200);  //initialize serial communication at 115200 bits per second 
+  while (!P1.init()){ 
+    ; //Wait for Modules to Sign on   
+  }
+  scan.begin();
+
+  pressure = capture.addChannel(1, 1);     //Slot, channel
+  limitSwitch = capture.addChannel(2, 1);
+  capture.setTrigger(pressure, TRIGGER_RISING, 3000);
+  //capture.setStatusTrigger(pressure, QUALITY_BURNOUT | QUALITY_MISSING_24V);
+  capture.arm(20, 10);                     //Samples before and after the trigger
+}
+
+void loop(){  // the loop routine runs over and over again forever:
+  scan.update();     //Read every input in the base
+  capture.update();  //Record this scan and check the trigger
+
+  if(capture.captureDone()){
+    capture.arm(20, 10);  //Watch for the next fault while this one is printed
+
+    for(int i = 0; i < capture.samples(); i++){
+      Serial.print((int32_t)(capture.readTimestamp(i) - capture.readTimestamp(capture.triggerSample())));
+      Serial.print("us Pressure: ");
+      Serial.print(capture.read(i, pressure));
+      Serial.print(" Limit: ");
+      Serial.print(capture.read(i, limitSwitch));
+      if(i == capture.triggerSample()){
+        Serial.print(" <- Trigger");
+      }
+      Serial.println();
+    }
+  }
+}
@@ -110,6 +110,7 @@ uint8_t P1AM::init() {
 			dbLoc++;
 		}
 		baseSlot[i].dbLoc = dbLoc;		//MDB Location
+		baseSlot[i].driver = resolveDriver(mdb[dbLoc]);	//Module specific behaviour is looked up once here
 
 		//Grab MDB values and load them into variables for P1AM-100 and array to send to Base Controller
 		baseControllerConstants[0+i*7]  = mdb[dbLoc].diBytes;
@@ -130,7 +131,7 @@ uint8_t P1AM::init() {
 	for (uint32_t i = 0; i < slots; i++){ 	//default config routine
 		dbLoc = baseSlot[i].dbLoc;
 		if(mdb[dbLoc].configBytes > 0){				//Modules with config Bytes need to havea config loaded
-			cfgArray = loadConfigBuf(mdb[dbLoc].moduleID);	//Get pointer to default config for this module
+			cfgArray = (char *)moduleDefaultConfig(mdb[dbLoc]);	//Get pointer to default config for this module
 			while(!configureModule(cfgArray, i + 1)){		//configure module
 				debugPrintln("Working");
 			}
@@ -219,7 +220,7 @@ uint32_t P1AM::readDiscrete(uint8_t slot, uint8_t channel){
 	uint32_t data = 0;
 	uint8_t len = 0;
 	uint8_t mdbLoc = 0;
-	char rData[4] = {0,0,0,0};
+	uint8_t rData[4] = {0,0,0,0};
 
 	mdbLoc = baseSlot[slot-1].dbLoc;
 	len = mdb[mdbLoc].diBytes;
@@ -242,21 +243,22 @@ uint32_t P1AM::readDiscrete(uint8_t slot, uint8_t channel){
 		return 0;
 	}
 
+	syncBeforeRead();
 	rData[0] = READ_DISCRETE_HDR;
 	rData[1] = slot;
-	spiSendRecvBuf((uint8_t *)rData,2);
+	spiSendRecvBuf(rData,2);
 	memset(rData,0,4);		//clear buffer
 	if(spiTimeout(1000*200) == true){
-		spiSendRecvBuf((uint8_t *)rData,len,true);
-		data  = (rData[3]<<24);
-		data += (rData[2]<<16);
-		data += (rData[1]<<8);
-		data += (rData[0]<<0);
+		spiSendRecvBuf(rData,len,true);
+		data  = ((uint32_t)rData[3]<<24);	//Unsigned so bytes of 0x80 and above are not sign extended
+		data += ((uint32_t)rData[2]<<16);
+		data += ((uint32_t)rData[1]<<8);
+		data += ((uint32_t)rData[0]<<0);
 
 		if(channel != 0){
 			data = (data>>(channel-1)) & 1;	// shift and mask
 		}
-		dataSync();
+		syncAfterRead();
 		return data;
 	}
 	else{
@@ -318,9 +320,10 @@ void P1AM::writeDiscrete(uint32_t data,uint8_t slot, uint8_t channel){
 	}
 
 
+	syncBeforeWrite();
 	spiSendRecvBuf(tData,len+3);	//3 Header bytes plus data length
 
-	dataSync();
+	syncAfterWrite();
 	return;
 }
 
@@ -360,6 +363,7 @@ int P1AM::readAnalog(uint8_t slot, uint8_t channel){
 		return 0;
 	}
 
+	syncBeforeRead();
 	rData[0] = READ_ANALOG_HDR;
 	rData[1] = slot;
 	rData[2] = channel;
@@ -367,7 +371,7 @@ int P1AM::readAnalog(uint8_t slot, uint8_t channel){
 
 	if(spiTimeout(1000*200) == true){
 		data = spiSendRecvInt(DUMMY);
-		dataSync();
+		syncAfterRead();
 		return data;
 	}
 	else{
@@ -395,6 +399,167 @@ float P1AM::readTemperature(uint8_t slot, uint8_t channel){
 	return ourValue.temperature;		//return the float
 }
 
+/*******************************************************************************
+Description: Read a single analog input module channel together with its quality
+			 flags. The data and status bytes are read in one snapshot so the
+			 flags always describe the value returned.
+
+Parameters: -uint8_t slot - Slot to read from. Slots start at 1.
+			-uint8_t channel - Channel to read from. Channels start at 1.
+
+Returns: 	-channelReading - counts, quality flags, timestamp and scan sequence.
+			 quality is QUALITY_GOOD or a combination of the QUALITY_ defines.
+*******************************************************************************/
+channelReading P1AM::readAnalogQuality(uint8_t slot, uint8_t channel){
+	channelReading readings[9];		//Largest analog module has 9 channels of data
+	uint8_t channels = 0;
+
+	channels = readQuality(readings,slot);
+	if((channel <= 0) || (channel > channels)){
+		debugPrintln("This channel is not valid");
+		memset(&readings[0],0,sizeof(channelReading));
+		readings[0].quality = QUALITY_NO_DATA;
+		return readings[0];
+	}
+	return readings[channel-1];
+}
+
+/*******************************************************************************
+Description: Read a single temperature input module channel together with its
+			 quality flags. Channels that are not QUALITY_GOOD return NAN as
+			 their temperature so they can not be mistaken for a real reading.
+
+Parameters: -uint8_t slot - Slot to read from. Slots start at 1.
+			-uint8_t channel - Channel to read from. Channels start at 1.
+
+Returns: 	-channelReading - temperature, quality flags, timestamp and scan sequence.
+*******************************************************************************/
+channelReading P1AM::readTemperatureQuality(uint8_t slot, uint8_t channel){
+	channelReading reading;
+
+	reading = readAnalogQuality(slot,channel);
+	if(reading.quality != QUALITY_GOOD){
+		reading.temperature = NAN;
+	}
+	return reading;
+}
+
+/*******************************************************************************
+Description: Read every analog input channel of a module together with its
+			 quality flags in one snapshot.
+
+Parameters: -channelReading readings[] - Array to store one reading per channel.
+			 Must hold at least as many entries as the module has channels.
+			-uint8_t slot - Slot to read from. Slots start at 1.
+
+Returns: 	-uint8_t - Number of channels stored in readings[]. 0 on failure.
+*******************************************************************************/
+uint8_t P1AM::readQuality(channelReading readings[], uint8_t slot){
+	uint8_t mdbLoc = 0;
+	uint8_t aiLen = 0;
+	uint8_t stLen = 0;
+	uint8_t channels = 0;
+	uint8_t quality = 0;
+	uint32_t sequence = 0;
+	uint32_t timestamp = 0;
+	uint8_t rawData[36];
+	uint8_t statusData[12];
+	int32_t counts[9];
+	blockRegion regions[2];
+
+	if((slot < 1) || (slot > NUMBER_OF_MODULES)){
+		debugPrint("Slots must be between 1 and ");
+		debugPrintln(NUMBER_OF_MODULES);
+		return 0;
+	}
+
+	mdbLoc = baseSlot[slot-1].dbLoc;
+	aiLen = mdb[mdbLoc].aiBytes;
+	stLen = mdb[mdbLoc].statusBytes;
+	channels = aiLen / 4;		//4 bytes per channel
+
+	if(aiLen <= 0){
+		debugPrint("Slot ");
+		debugPrint(slot);
+		debugPrintln(": This module has no Analog Input bytes");
+		return 0;
+	}
+
+	memset(statusData,0,sizeof(statusData));
+	regions[0] = {(char *)rawData, aiLen, blockOffset(slot,ANALOG_IN_BLOCK), ANALOG_IN_BLOCK};
+	regions[1] = {(char *)statusData, stLen, blockOffset(slot,STATUS_IN_BLOCK), STATUS_IN_BLOCK};
+
+	sequence = readBlockSnapshot(regions, (stLen > 0) ? 2 : 1);
+	timestamp = (sequence != 0) ? scanTimestamp : micros();	//Stamp good data with the scan it came from
+	decodeAnalogBlock(rawData,counts,channels);
+
+	for(int i = 0; i < channels; i++){
+		quality = QUALITY_GOOD;
+		if(sequence == 0){
+			quality |= QUALITY_NO_DATA;
+		}
+		if(stLen > BURNOUT_STATUS){
+			quality |= ((statusData[BURNOUT_STATUS] >> i) & 1) ? QUALITY_BURNOUT : 0;
+		}
+		if(stLen > UNDER_RANGE_STATUS){
+			quality |= ((statusData[UNDER_RANGE_STATUS] >> i) & 1) ? QUALITY_UNDER_RANGE : 0;
+		}
+		if(stLen > OVER_RANGE_STATUS){
+			quality |= ((statusData[OVER_RANGE_STATUS] >> i) & 1) ? QUALITY_OVER_RANGE : 0;
+		}
+		if(stLen > MISSING24V_STATUS){
+			quality |= ((statusData[MISSING24V_STATUS] >> 1) & 1) ? QUALITY_MISSING_24V : 0;
+		}
+
+		readings[i].counts = counts[i];
+		readings[i].quality = quality;
+		readings[i].timestamp = timestamp;
+		readings[i].scanSequence = sequence;
+	}
+
+	return channels;
+}
+
+/*******************************************************************************
+Description: Calculate the byte offset of a slot's data in one of the Base
+			 Controller data blocks. Each module's data follows the modules in
+			 the slots before it.
+
+Parameters: -uint8_t slot - Slot of the module. Slots start at 1.
+			-uint8_t type - DISCRETE_IN_BLOCK, ANALOG_IN_BLOCK, DISCRETE_OUT_BLOCK,
+			 ANALOG_OUT_BLOCK or STATUS_IN_BLOCK
+
+Returns: 	-uint16_t - Offset of the first byte of the slot's data in the block
+*******************************************************************************/
+uint16_t P1AM::blockOffset(uint8_t slot, uint8_t type){
+	uint16_t offset = 0;
+	uint8_t tempLoc = 0;
+
+	for(int i = 0; (i < slot-1) && (i < NUMBER_OF_MODULES); i++){
+		tempLoc = baseSlot[i].dbLoc;
+		switch(type){
+			case DISCRETE_IN_BLOCK:
+				offset += mdb[tempLoc].diBytes;
+				break;
+			case ANALOG_IN_BLOCK:
+				offset += mdb[tempLoc].aiBytes;
+				break;
+			case DISCRETE_OUT_BLOCK:
+				offset += mdb[tempLoc].doBytes;
+				break;
+			case ANALOG_OUT_BLOCK:
+				offset += mdb[tempLoc].aoBytes;
+				break;
+			case STATUS_IN_BLOCK:
+				offset += mdb[tempLoc].statusBytes;
+				break;
+			default:
+				break;
+		}
+	}
+	return offset;
+}
+
 /*******************************************************************************
 Description: Write to a single analog output module channel.
 
@@ -437,9 +602,10 @@ void P1AM::writeAnalog(uint32_t data,uint8_t slot, uint8_t channel){
 	tData[4] = (data>>8)  & 0xFF;
 	tData[5] = (data>>16) & 0xFF;
 	tData[6] = (data>>24) & 0xFF;
+	syncBeforeWrite();
 	spiSendRecvBuf(tData,7);
 
-	dataSync();
+	syncAfterWrite();
 	return;
 }
 
@@ -460,23 +626,10 @@ Parameters: -char buf[] - Pointer to an array that will hold the values read. Th
 Returns: 	-None
 *******************************************************************************/
 void P1AM::readBlockData(char buf[], uint16_t len,uint16_t offset, uint8_t type){
-	uint8_t readParams[6];
-
-	if((len+offset) > 1200){		//max of data array is 1200, so we can't read past that
-		len = 1200-offset;		//adjust len in case we're trying to read too far
-	}
 
-	readParams[0] = READ_BLOCK_HDR;
-	readParams[1] = type;		// 0 is Discrete In, 1 is Analog In, 2 is Discrete Out, 3 is Analog Out,4 is Status
-	readParams[2] = len >> 8;
-	readParams[3] = len & 0xFF;
-	readParams[4] = offset >> 8;
-	readParams[5] = offset & 0xFF;
-	spiSendRecvBuf(readParams,6);			//Send paramters for block read
-
-	if(spiTimeout(1000*200) == true){
-		spiSendRecvBuf((uint8_t *)buf,len,true);		//data is stored in buffer passed in
-		dataSync();
+	syncBeforeRead();
+	if(readBlockRaw(buf,len,offset,type) == true){
+		syncAfterRead();
 		return;
 	}
 	else{
@@ -486,6 +639,223 @@ void P1AM::readBlockData(char buf[], uint16_t len,uint16_t offset, uint8_t type)
 	}
 }
 
+/*******************************************************************************
+Description: Read several regions of the Base Controller data blocks as one
+			 snapshot. The read starts right at the end of a Base Controller
+			 scan and every region is read back to back, so e.g. analog data
+			 and its status bytes come from the same scan as long as the reads
+			 finish in the idle time before the next scan. Keep snapshots short.
+
+			 The ack line is checked after every region. If it is low the Base
+			 Controller may have started another scan, so the snapshot is
+			 treated as torn and the whole read is retried. The ack line also
+			 carries the command handshake and the Base Controller has no scan
+			 counter to read, so this check is best effort: a handshake seen
+			 there only costs a retry, but a scan that starts and ends inside
+			 one region read is not seen.
+
+Parameters: -blockRegion regions[] - Array of regions to read. Each region holds
+			 the buffer, length, offset and block type as used by readBlockData.
+			-uint8_t numberOfRegions - Number of entries in regions[]
+
+Returns: 	-uint32_t - Scan sequence number the snapshot was taken from. The
+			 number goes up by one for each scan a snapshot is aligned to, so a
+			 newer snapshot always has a higher number. Scans that end while no
+			 snapshot is being taken are not counted, so numbers one apart are
+			 not always consecutive scans. Returns 0 if a coherent snapshot
+			 could not be taken.
+*******************************************************************************/
+uint32_t P1AM::readBlockSnapshot(blockRegion regions[], uint8_t numberOfRegions){
+	uint32_t sequence = 0;
+	bool torn = false;
+
+	for(int attempt = 0; attempt < SNAPSHOT_RETRIES; attempt++){
+		if(!dataSync()){			//Align to the end of a scan
+			continue;
+		}
+		sequence = ++scanSequence;	//Only scans a snapshot was aligned to are counted
+		scanTimestamp = micros();	//Data in the block is from the scan that just ended
+		torn = false;
+
+		for(int i = 0; i < numberOfRegions; i++){
+			if(readBlockRaw(regions[i].buf,regions[i].len,regions[i].offset,regions[i].type) == false){
+				torn = true;
+				break;
+			}
+			if(!digitalRead(slaveAckPin)){
+				torn = true;		//Base Controller may have started another scan. Checked after the last region too
+				break;
+			}
+		}
+
+		if(!torn){
+			syncAfterRead();
+			return sequence;
+		}
+	}
+
+	debugPrintln("Snapshot torn");
+	return 0;
+}
+
+/*******************************************************************************
+Description: Returns the number of Base Controller scans readBlockSnapshot has
+			 aligned to since power up. This is the same counter reported by
+			 readBlockSnapshot.
+
+Parameters: -None
+
+Returns: 	-uint32_t - Current scan sequence number
+*******************************************************************************/
+uint32_t P1AM::getScanSequence(){
+
+	return scanSequence;
+
+}
+
+/*******************************************************************************
+Description: Returns micros() at the end of the Base Controller scan the last
+			 readBlockSnapshot was aligned to. Use it to timestamp snapshot data,
+			 since a stamp taken before the snapshot is early by the alignment
+			 wait and one taken after it is late by the sync that follows.
+
+Parameters: -None
+
+Returns: 	-uint32_t - micros() when the scan of the last snapshot ended
+*******************************************************************************/
+uint32_t P1AM::getScanTimestamp(){
+
+	return scanTimestamp;
+
+}
+
+/*******************************************************************************
+Description: Read a small window of Analog Input channels as fast as the bus
+			 allows. The slot and channels are checked once, then the window is
+			 read back to back with no scan sync between samples, so the sample
+			 rate is only limited by the SPI transfer and the Base Controller
+			 scan. Each sample is stamped with micros().
+
+			 The Base Controller only updates its data once per scan, so
+			 sampling faster than the scan returns the same data more than once
+			 and sampling slower misses scans. Both are counted in the result.
+			 A sample is new if the Base Controller was seen scanning since the
+			 last sample. Skipped scans are estimated from
+			 the time between new samples and the scan period measured at the
+			 start of the burst.
+
+Parameters: -char buf[] - Buffer for the samples. Needs samples * count * 4 bytes.
+			 Data is stored as read from the Base Controller, 4 big endian bytes
+			 per channel. Use decodeAnalogBlock to convert it to counts.
+			-uint32_t timestamps[] - micros() of each sample. Pass NULL if not needed.
+			-uint16_t samples - Number of samples to take
+			-uint8_t slot - Slot to read from. Slots start at 1.
+			-uint8_t firstChannel - First channel of the window. Channels start at 1.
+			-uint8_t count - Number of channels in the window
+
+Returns: 	-burstStats - Samples taken, achieved rate, measured scan period and
+			 the number of repeated and skipped scans. samples is 0 if the
+			 window is not valid or the scan period could not be measured.
+*******************************************************************************/
+burstStats P1AM::readAnalogBurst(char buf[], uint32_t timestamps[], uint16_t samples, uint8_t slot, uint8_t firstChannel, uint8_t count){
+	burstStats stats = {0,0,0,0,0,0};
+	uint8_t mdbLoc = 0;
+	uint16_t offset = 0;
+	uint16_t len = 0;
+	uint32_t start = 0;
+	uint32_t now = 0;
+	uint32_t lastNew = 0;
+	uint32_t wait = 0;
+	uint32_t scans = 0;
+	bool newScan = false;
+	bool timedOut = false;
+	char *sample = buf;
+
+	if((slot < 1) || (slot > NUMBER_OF_MODULES)){
+		debugPrint("Slots must be between 1 and ");
+		debugPrintln(NUMBER_OF_MODULES);
+		return stats;
+	}
+
+	mdbLoc = baseSlot[slot-1].dbLoc;
+
+	if(mdb[mdbLoc].aiBytes <= 0){
+		debugPrint("Slot ");
+		debugPrint(slot);
+		debugPrintln(": This module has no Analog Input bytes");
+		return stats;
+	}
+
+	if((firstChannel <= 0) || (count == 0) || ((firstChannel + count - 1) * 4 > mdb[mdbLoc].aiBytes)){
+		debugPrintln("This channel is not valid");
+		return stats;
+	}
+
+	len = count * 4;		//4 bytes per channel
+	offset = blockOffset(slot,ANALOG_IN_BLOCK) + ((firstChannel - 1) * 4);
+
+	syncBeforeRead();
+	if(!dataSync()){		//Measure one scan and start the burst at the end of it
+		return stats;
+	}
+	start = micros();
+	if(!dataSync()){
+		return stats;
+	}
+	now = micros();
+	stats.scanPeriod = now - start;
+	start = now;
+	lastNew = now;
+
+	for(uint16_t i = 0; i < samples; i++){
+		newScan = (i == 0);
+		wait = micros();
+		while(!digitalRead(slaveAckPin)){		//Base Controller is scanning. Wait for it to finish
+			newScan = true;
+			if(micros() - wait >= 200000UL){
+				timedOut = true;
+				break;
+			}
+		}
+		if(timedOut){
+			debugPrintln("Base Sync Timeout");
+			break;
+		}
+
+		now = micros();
+		if(readBlockRaw(sample,len,offset,ANALOG_IN_BLOCK) == false){
+			break;
+		}
+		if(timestamps != NULL){
+			timestamps[i] = now;
+		}
+
+		if(newScan){
+			if((i > 0) && (stats.scanPeriod > 0)){
+				scans = (now - lastNew + (stats.scanPeriod / 2)) / stats.scanPeriod;
+				if(scans > 1){
+					stats.skippedScans += scans - 1;
+				}
+			}
+			lastNew = now;
+		}
+		else{
+			stats.repeatedScans++;
+		}
+
+		stats.samples++;
+		sample += len;
+	}
+
+	stats.elapsed = micros() - start;
+	if(stats.elapsed > 0){
+		stats.rate = ((uint64_t)stats.samples * 1000000UL) / stats.elapsed;
+	}
+
+	syncAfterRead();
+	return stats;
+}
+
 /*******************************************************************************
 Description: Write to a block of data stored in Base Controller. This allows you to write data
 			 to many modules in one command, but requires you to calculate the
@@ -505,20 +875,21 @@ Returns: 	-None
 *******************************************************************************/
 void P1AM::writeBlockData(char buf[], uint16_t len,uint16_t offset, uint8_t type){
 
+	uint8_t writeParams[6];
+
 	if((len+offset) > 1200){		//max of data array is 1200, so we can't read past that
 		len = 1200-offset;		//adjust len in case we're trying to read too far
 	}
-	uint8_t *tData = (uint8_t *)malloc(len+6);
-	tData[0] = WRITE_BLOCK_HDR;
-	tData[1] = type;		
-	tData[2] = len >> 8;
-	tData[3] = len & 0xFF;
-	tData[4] = offset >> 8;
-	tData[5] = offset & 0xFF;
-	memcpy(tData+6,buf,len);
-	spiSendRecvBuf(tData,len+6,0);	//data is not stored in passed buffer
-	free(tData);
-	dataSync();
+
+	writeParams[0] = WRITE_BLOCK_HDR;
+	writeParams[1] = type;		// 0 is Discrete In, 1 is Analog In, 2 is Discrete Out, 3 is Analog Out,4 is Status
+	writeParams[2] = len >> 8;
+	writeParams[3] = len & 0xFF;
+	writeParams[4] = offset >> 8;
+	writeParams[5] = offset & 0xFF;
+	syncBeforeWrite();
+	spiSendGatherBuf(writeParams,6,(uint8_t *)buf,len);	//Header and data back to back. No copy of the caller's buffer is made
+	syncAfterWrite();
 	return;
 }
 
@@ -533,13 +904,46 @@ Parameters: -float duty - Duty cycle. Range 0.00-100.00. You can include up to 2
 Returns: 	-None
 *******************************************************************************/
 void P1AM::writePWM(float duty,uint32_t freq,uint8_t slot,uint8_t channel){
-	uint8_t mdbLoc = 0;
-	uint8_t tempLoc = 0;
-	uint8_t offset = 0;
-	uint32_t dutyInt = 0;
-	char tData[8];
 
-	mdbLoc = baseSlot[slot-1].dbLoc;
+	writePWMFixed((uint16_t)(duty * 100 + 0.5f),freq,slot,channel);// shift decimal over 2 places and round. e.g. 12.3456 turns into 1235
+	return;
+}
+
+/*******************************************************************************
+Description: Set both duty cycle and frequency of a PWM output module channel
+			 using an integer duty cycle. Avoids the floating point math of
+			 writePWM, which is done in software on the P1AM-100.
+
+Parameters: -uint16_t duty - Duty cycle in hundredths of a percent. Range 0-10000. e.g. 1234 is 12.34%
+			-uint32_t freq - Frequency. See module data sheet for range. P1-04PWM is 0-20kHz.
+			-uint8_t slot - Slot to write to. Slots start at 1.
+			-uint8_t channel - Channel to write to. Channels start at 1.
+
+Returns: 	-None
+*******************************************************************************/
+void P1AM::writePWMFixed(uint16_t duty,uint32_t freq,uint8_t slot,uint8_t channel){
+
+	writePWMFixed(&duty,&freq,slot,channel,1);
+	return;
+}
+
+/*******************************************************************************
+Description: Set the duty cycle and frequency of several consecutive channels of
+			 a PWM output module in one block write.
+
+Parameters: -const uint16_t duty[] - Duty cycles in hundredths of a percent. Range 0-10000.
+			 Nothing is sent if any duty is out of range.
+			-const uint32_t freq[] - Frequencies. See module data sheet for range. P1-04PWM is 0-20kHz.
+			-uint8_t slot - Slot to write to. Slots start at 1.
+			-uint8_t firstChannel - First channel to write. Channels start at 1.
+			-uint8_t count - Number of channels. duty and freq need this many entries.
+
+Returns: 	-None
+*******************************************************************************/
+void P1AM::writePWMFixed(const uint16_t duty[],const uint32_t freq[],uint8_t slot,uint8_t firstChannel,uint8_t count){
+	uint16_t offset = 0;
+	char tData[32];
+	int32_t registers[8];
 
 	if((slot < 1) || (slot > NUMBER_OF_MODULES)){
 		debugPrint("Slots must be between 1 and ");
@@ -547,39 +951,36 @@ void P1AM::writePWM(float duty,uint32_t freq,uint8_t slot,uint8_t channel){
 		return;
 	}
 
-	if((channel <= 0) || (channel > 4)){		
+
+	if((firstChannel <= 0) || (count == 0) || ((firstChannel + count - 1) > 4)){
 		debugPrintln("This channel is not valid");
 		return;
 	}
 
-	if((mdb[mdbLoc].dataSize & 0xF0) !=  0xA0){		//Is this PWM
+	for(int i = 0; i < count; i++){
+		if(duty[i] > 10000){
+			debugPrintln("Duty cycle is not valid");
+			return;		//Nothing is sent if any channel is out of range
+		}
+	}
+
+	if(!isFamily(slot,DRIVER_PWM)){		//Is this PWM
 		debugPrint("Slot ");
 		debugPrint(slot);
 		debugPrintln(": This module is not a PWM module");
 		return;		//Not PWM
 	}
 
-	for(int i=0;i<slot-1;i++){
-		tempLoc = baseSlot[i].dbLoc;
-		if(mdb[tempLoc].aoBytes > 0){
-			offset += mdb[tempLoc].aoBytes;		//get offset of analog bytes
-		}
-	}
+	offset = blockOffset(slot,ANALOG_OUT_BLOCK);	//get offset of analog bytes
+	offset += (firstChannel - 1) * 8;	//Each channel uses 8 bytes
 
-	offset += (channel - 1) * 8;	//Each channel uses 8 bytes
-	dutyInt = (uint32_t)(duty * 100);// shift decimal over 2 places and cast off remainder. e.g. 12.3456 turns into 1234
-
-	tData[3] = (dutyInt>>0)  & 0xFF;	//shift and mask to bytes
-	tData[2] = (dutyInt>>8)  & 0xFF;
-	tData[1] = (dutyInt>>16) & 0xFF;
-	tData[0] = (dutyInt>>24) & 0xFF;
-	tData[7] = (freq>>0)  & 0xFF;
-	tData[6] = (freq>>8)  & 0xFF;
-	tData[5] = (freq>>16) & 0xFF;
-	tData[4] = (freq>>24) & 0xFF;
+	for(int i = 0; i < count; i++){
+		registers[i*2] = duty[i];			//Each channel uses 2 registers. Duty then frequency
+		registers[(i*2)+1] = freq[i];
+	}
+	encodeAnalogBlock(registers,(uint8_t *)tData,count * 2);
 
-	writeBlockData(tData, 8, offset, ANALOG_OUT_BLOCK); //Use block data to ensure duty/freq are entered at the same time.
-	dataSync();
+	writeBlockData(tData, count * 8, offset, ANALOG_OUT_BLOCK); //Use block data to ensure duty/freq are entered at the same time.
 
 	return;
 }
@@ -594,34 +995,49 @@ Parameters: -float duty - Duty cycle. Range 0.00-100.00. You can include up to 2
 Returns: 	-None
 *******************************************************************************/
 void P1AM::writePWMDuty(float duty,uint8_t slot,uint8_t channel){
-	uint8_t mdbLoc = 0;
-	uint32_t dutyInt = 0;
 
-	mdbLoc = baseSlot[slot-1].dbLoc;
+	writePWMDutyFixed((uint16_t)(duty * 100 + 0.5f),slot,channel);// shift decimal over 2 places and round. e.g. 12.3456 turns into 1235
+	return;
+}
+
+/*******************************************************************************
+Description: Set duty cycle of a PWM output module channel using an integer
+			 duty cycle. Avoids the floating point math of writePWMDuty.
+
+Parameters: -uint16_t duty - Duty cycle in hundredths of a percent. Range 0-10000. e.g. 1234 is 12.34%
+			-uint8_t slot - Slot to write to. Slots start at 1.
+			-uint8_t channel - Channel to write to. Channels start at 1.
+
+Returns: 	-None
+*******************************************************************************/
+void P1AM::writePWMDutyFixed(uint16_t duty,uint8_t slot,uint8_t channel){
 
 	if((slot < 1) || (slot > NUMBER_OF_MODULES)){
 		debugPrint("Slots must be between 1 and ");
 		debugPrintln(NUMBER_OF_MODULES);
 		return;
 	}
-	
-	if((channel <= 0) || (channel > 4)){		
+
+
+	if((channel <= 0) || (channel > 4)){
 		debugPrintln("This channel is not valid");
 		return;
 	}
 
-	if((mdb[mdbLoc].dataSize & 0xF0) !=  0xA0){		//Is this PWM
+	if(duty > 10000){
+		debugPrintln("Duty cycle is not valid");
+		return;
+	}
+
+	if(!isFamily(slot,DRIVER_PWM)){		//Is this PWM
 		debugPrint("Slot ");
 		debugPrint(slot);
 		debugPrintln(": This module is not a PWM module");
 		return;		//Not PWM
 	}
 
-	dutyInt = (uint32_t)(duty * 100);// shift decimal over 2 places and cast off remainder. e.g. 12.3456 turns into 1234
 	channel = 1 + ((channel-1) * 2);
-	P1.writeAnalog(dutyInt,slot,channel);
-
-	dataSync();
+	P1.writeAnalog(duty,slot,channel);
 	return;
 }
 
@@ -635,9 +1051,6 @@ Parameters: -uint32_t freq - Frequency. See module data sheet for range. P1-04PW
 Returns: 	-None
 *******************************************************************************/
 void P1AM::writePWMFreq(uint32_t freq,uint8_t slot,uint8_t channel){
-	uint8_t mdbLoc = 0;
-
-	mdbLoc = baseSlot[slot-1].dbLoc;
 
 	if((slot < 1) || (slot > NUMBER_OF_MODULES)){
 		debugPrint("Slots must be between 1 and ");
@@ -650,7 +1063,7 @@ void P1AM::writePWMFreq(uint32_t freq,uint8_t slot,uint8_t channel){
 		return;
 	}
 
-	if((mdb[mdbLoc].dataSize & 0xF0) !=  0xA0){		//Is this PWM
+	if(!isFamily(slot,DRIVER_PWM)){		//Is this PWM
 		debugPrint("Slot ");
 		debugPrint(slot);
 		debugPrintln("This module is not a PWM module");
@@ -659,8 +1072,6 @@ void P1AM::writePWMFreq(uint32_t freq,uint8_t slot,uint8_t channel){
 
 	channel = 2 + ((channel-1) * 2);
 	P1.writeAnalog(freq,slot,channel);
-
-	dataSync();
 	return;
 }
 
@@ -675,9 +1086,6 @@ Parameters: -bool data - Set channel on or off
 Returns: 	-None
 *******************************************************************************/
 void P1AM::writePWMDir(bool data,uint8_t slot, uint8_t channel){
-	 uint8_t mdbLoc = 0;
-
-	mdbLoc = baseSlot[slot-1].dbLoc;
 
 	if((slot < 1) || (slot > NUMBER_OF_MODULES)){
 		debugPrint("Slots must be between 1 and ");
@@ -690,7 +1098,7 @@ void P1AM::writePWMDir(bool data,uint8_t slot, uint8_t channel){
 		return;
 	}
 
-	if((mdb[mdbLoc].dataSize & 0xF0) !=  0xA0){		//Is this PWM
+	if(!isFamily(slot,DRIVER_PWM)){		//Is this PWM
 		debugPrint("Slot ");
 		debugPrint(slot);
 		debugPrintln(": This module is not a PWM module");
@@ -699,8 +1107,6 @@ void P1AM::writePWMDir(bool data,uint8_t slot, uint8_t channel){
 
 	channel = 1 + ((channel-1) * 2);
 	P1.writeAnalog(data,slot,channel);
-
-	dataSync();
 	return;
 }
 
@@ -768,6 +1174,26 @@ moduleProps P1AM::readSlotProps(uint8_t slot){
 	return _slotProps;
 }
 
+/*******************************************************************************
+Description: Returns the driver the module in a slot was given at sign-on. The
+			 driver's family tells what kind of module it is, e.g. DRIVER_PWM,
+			 without checking module IDs or data sizes.
+
+Parameters: -uint8_t slot - Slot to check. Slots start at 1.
+
+Returns: 	-const P1_Driver * - Driver of the module. NULL for an empty or
+			 invalid slot.
+*******************************************************************************/
+const P1_Driver *P1AM::readSlotDriver(uint8_t slot){
+
+	if((slot < 1) || (slot > NUMBER_OF_MODULES)){
+		debugPrint("Slots must be between 1 and ");
+		debugPrintln(NUMBER_OF_MODULES);
+		return NULL;
+	}
+	return baseSlot[slot-1].driver;
+}
+
 /*******************************************************************************
 Description: Read a single status byte from a single module
 
@@ -798,6 +1224,7 @@ char P1AM::readStatus(int byteNum,int slot){
 		return 0;		//No status Bytes
 	}
 
+	syncBeforeRead();
 	rData[0] = READ_STATUS_HDR;
 	rData[1] = slot;
 	rData[2] = len;
@@ -806,7 +1233,7 @@ char P1AM::readStatus(int byteNum,int slot){
 
 	if(spiTimeout(1000*200) == true){
 		spiSendRecvBuf((uint8_t *)buf,len,true);	//data is stored in buffer passed in
-		dataSync();
+		syncAfterRead();
 		return buf[0];
 	}
 	else{
@@ -846,6 +1273,7 @@ void P1AM::readStatus(char buf[], uint8_t slot){
 		return;		//No status Bytes
 	}
 
+	syncBeforeRead();
 	rData[0] = READ_STATUS_HDR;
 	rData[1] = slot;
 	rData[2] = len;
@@ -854,7 +1282,7 @@ void P1AM::readStatus(char buf[], uint8_t slot){
 
 	if(spiTimeout(1000*200) == true){
 		spiSendRecvBuf((uint8_t *)buf,len,true);	//data is stored in buffer passed in
-		dataSync();
+		syncAfterRead();
 		return;
 	}
 	else{
@@ -1278,6 +1706,16 @@ void P1AM::writePWMDir(bool data, channelLabel label){
 	return;
 }
 
+void P1AM::writePWMFixed(uint16_t duty, uint32_t freq, channelLabel label){
+	writePWMFixed(duty,freq,label.slot,label.channel);
+	return;
+}
+
+void P1AM::writePWMDutyFixed(uint16_t duty, channelLabel label){
+	writePWMDutyFixed(duty,label.slot,label.channel);
+	return;
+}
+
 uint8_t P1AM::checkUnderRange(channelLabel label){
 	return checkUnderRange(label.slot,label.channel);
 }
@@ -1290,18 +1728,124 @@ uint8_t P1AM::checkBurnout(channelLabel label){
 	return checkBurnout(label.slot,label.channel);
 }
 
+channelReading P1AM::readAnalogQuality(channelLabel label){
+	return readAnalogQuality(label.slot,label.channel);
+}
+
+channelReading P1AM::readTemperatureQuality(channelLabel label){
+	return readTemperatureQuality(label.slot,label.channel);
+}
+
+/*******************************************************************************
+Description: Select how the library waits for the Base Controller after data
+			 reads and writes.
+			 SYNC_STRICT waits one full Base Controller scan after every command.
+			 SYNC_DEFERRED does not wait after reads. Writes are marked pending
+			 and synced once, either by the next read or by calling sync(), so a
+			 batch of writes pays for one scan instead of one each.
+			 SYNC_NONE never waits. Reads may return data from before a
+			 previous write has been scanned out to the modules.
+			 With every policy a data write first waits, at most 200ms, for the
+			 Base Controller to be out of its scan, so back to back writes never
+			 land in the middle of a scan.
+			 Configuration, watchdog and sign-on functions always use SYNC_STRICT.
+
+Parameters: -uint8_t policy - SYNC_STRICT, SYNC_DEFERRED or SYNC_NONE
+
+Returns: 	-None
+*******************************************************************************/
+void P1AM::setSyncPolicy(uint8_t policy){
+
+	if(syncPending && (policy != SYNC_DEFERRED)){
+		dataSync();			//Don't leave writes behind when leaving deferred mode
+	}
+	syncPolicy = policy;
+
+}
+
+/*******************************************************************************
+Description: Returns the sync policy set by setSyncPolicy
+
+Parameters: -None
+
+Returns: 	-uint8_t - SYNC_STRICT, SYNC_DEFERRED or SYNC_NONE
+*******************************************************************************/
+uint8_t P1AM::getSyncPolicy(){
+
+	return syncPolicy;
+
+}
+
+/*******************************************************************************
+Description: Wait for the Base Controller to scan out any writes that are still
+			 pending. Call at the end of a batch of writes when using SYNC_DEFERRED.
+			 Does nothing if no writes are pending.
+
+Parameters: -None
+
+Returns: 	-None
+*******************************************************************************/
+void P1AM::sync(){
+
+	if(syncPending){
+		dataSync();
+	}
+
+}
+
 /*******************************************************************************
 PRIVATE FUNCTIONS FOR P1AM.h
 *******************************************************************************/
-void P1AM::dataSync(){
+void P1AM::syncBeforeRead(){
+
+	if(syncPending){
+		dataSync();			//Make sure earlier writes are scanned out before reading
+	}
+
+}
+
+void P1AM::syncAfterRead(){
+
+	if(syncPolicy == SYNC_STRICT){
+		dataSync();
+	}
+
+}
+
+void P1AM::syncBeforeWrite(){
+	uint32_t startMillis = millis();
+
+	while(!digitalRead(slaveAckPin)){		//Base Controller is in its scan. Don't let the write land in the middle of it
+		if(millis() - startMillis >= 200){
+			debugPrintln("Base Sync Timeout");
+			break;
+		}
+	}
+
+}
+
+void P1AM::syncAfterWrite(){
+
+	if(syncPolicy == SYNC_STRICT){
+		dataSync();
+	}
+	else if(syncPolicy == SYNC_DEFERRED){
+		syncPending = true;
+	}
+
+}
+
+bool P1AM::dataSync(){
 	uint32_t currentMillis = 0;
 	uint32_t startMillis = 0;
+	bool synced = true;
 	
 	startMillis = millis();
 	while(!digitalRead(slaveAckPin)){
 		currentMillis = millis();
 		if(currentMillis - startMillis >= 200){
 			debugPrintln("Base Sync Timeout");
+			synced = false;
 			break;
 		}
 	}
@@ -1312,6 +1856,7 @@ void P1AM::dataSync(){
 		currentMillis = millis();
 		if(currentMillis - startMillis >= 200){
 			debugPrintln("Base Sync Timeout");
+			synced = false;
 			break;
 		}
 	}
@@ -1322,51 +1867,42 @@ void P1AM::dataSync(){
 		currentMillis = millis();
 		if(currentMillis - startMillis >= 200){
 			debugPrintln("Base Sync Timeout");
+			synced = false;
 			break;
 		}
 	}
 	delayMicroseconds(1);
 	
-	return;
+	syncPending = false;
+	return synced;		//true if the start and end of a full Base Controller scan were seen
 }
 
-char *P1AM::loadConfigBuf(int moduleID){
+bool P1AM::isFamily(uint8_t slot, uint8_t family){
+	const P1_Driver *driver = baseSlot[slot-1].driver;
 
-	switch(moduleID){
-		 case 0x34605582:
-			return (char*)P1_04AD_1_DEFAULT_CONFIG;
-			break;
-		case 0x34605583:
-			return (char*)P1_04AD_2_DEFAULT_CONFIG;
-			break;
-		case 0x34605590:
-			return (char*)P1_04ADL_2_DEFAULT_CONFIG;
-		case 0x34608C8E:
-			return (char*)P1_04NTC_DEFAULT_CONFIG;
-		case 0x34608C81:
-			return (char*)P1_04THM_DEFAULT_CONFIG;
-		case 0x34605588:
-			return (char*)P1_04RTD_DEFAULT_CONFIG;
-		case 0x34605581:
-			return (char*)P1_04AD_DEFAULT_CONFIG;
-		case 0x3460558F:
-			return (char*)P1_04ADL_1_DEFAULT_CONFIG;
-		case 0x34A0558A:
-			return (char*)P1_08ADL_1_DEFAULT_CONFIG;
-		case 0x34A0558B:
-			return (char*)P1_08ADL_2_DEFAULT_CONFIG;
-		case 0x5461A783:
-			return (char*)P1_04ADL2DAL_1_DEFAULT_CONFIG;
-		case 0x5461A784:
-			return (char*)P1_04ADL2DAL_2_DEFAULT_CONFIG;
-		case 0x1403F481:
-			return (char*)P1_04PWM_DEFAULT_CONFIG;
-		case 0x34A5A481:
-			return (char*)P1_02HSC_DEFAULT_CONFIG;
-		default:
-			break;
+	return (driver != NULL) && (driver->family() == family);
+}
+
+bool P1AM::readBlockRaw(char buf[], uint16_t len, uint16_t offset, uint8_t type){
+	uint8_t readParams[6];
+
+	if((len+offset) > 1200){		//max of data array is 1200, so we can't read past that
+		len = 1200-offset;		//adjust len in case we're trying to read too far
 	}
-	return (char*)P1_04ADL_1_DEFAULT_CONFIG;
+
+	readParams[0] = READ_BLOCK_HDR;
+	readParams[1] = type;		// 0 is Discrete In, 1 is Analog In, 2 is Discrete Out, 3 is Analog Out,4 is Status
+	readParams[2] = len >> 8;
+	readParams[3] = len & 0xFF;
+	readParams[4] = offset >> 8;
+	readParams[5] = offset & 0xFF;
+	spiSendRecvBuf(readParams,6);			//Send paramters for block read
+
+	if(spiTimeout(1000*200) == true){
+		spiSendRecvBuf((uint8_t *)buf,len,true);		//data is stored in buffer passed in
+		return true;
+	}
+	return false;
 }
 
 bool P1AM::handleHDR(uint8_t HDR){
@@ -1411,10 +1947,10 @@ uint32_t P1AM::spiSendRecvInt(uint32_t data){
     _P1AM_SPI.endTransaction();
 	_P1AM_SPI.end();
 
-	returnInt  = (rData[3]<<24);
-	returnInt += (rData[2]<<16);
-	returnInt += (rData[1]<<8);
-	returnInt += (rData[0]<<0);
+	returnInt  = ((uint32_t)rData[3]<<24);
+	returnInt += ((uint32_t)rData[2]<<16);
+	returnInt += ((uint32_t)rData[1]<<8);
+	returnInt += ((uint32_t)rData[0]<<0);
 
 	return returnInt;
 }
@@ -1442,6 +1978,37 @@ void P1AM::spiSendRecvBuf(uint8_t *buf, int len, bool returnData){
 	return;
 }
 
+/*******************************************************************************
+Description: Send two buffers back to back under a single chip select. Used to
+			 send a command header followed by a payload without first copying
+			 both into one contiguous buffer. Received data is discarded.
+
+Parameters: -const uint8_t *hdr - Header bytes sent first
+			-int hdrLen - Number of header bytes
+			-const uint8_t *buf - Payload bytes sent directly after the header
+			-int len - Number of payload bytes
+
+Returns: 	-None
+*******************************************************************************/
+void P1AM::spiSendGatherBuf(const uint8_t *hdr, int hdrLen, const uint8_t *buf, int len){
+
+	_P1AM_SPI.begin();
+	_P1AM_SPI.beginTransaction(P100_SPI_SETTINGS);
+	digitalWrite(slaveSelectPin, LOW);
+
+	for(int i = 0; i < hdrLen; ++i){
+		_P1AM_SPI.transfer(hdr[i]);
+	}
+	for(int i = 0; i < len; ++i){
+		_P1AM_SPI.transfer(buf[i]);
+	}
+
+	digitalWrite(slaveSelectPin, HIGH);
+	_P1AM_SPI.endTransaction();
+	_P1AM_SPI.end();
+	return;
+}
+
 bool P1AM::spiTimeout(uint32_t uS,uint8_t resendMsg,uint16_t retryPeriod){
 	uint16_t retryTime = 0;
 
@@ -1474,8 +2041,6 @@ bool P1AM::Base_Controller_FW_UPDATE(unsigned int fwLen){
 	uint8_t status = 0;
 	uint8_t tData[9];
 
-	uint8_t *chunkBuffer = (uint8_t *)malloc(chunkSize);	//Make spacs for FW chunks
-
 	_P1AM_SPI.begin();			//Start SPI
 	Serial.println("Establishing Communication");
 
@@ -1515,9 +2080,8 @@ bool P1AM::Base_Controller_FW_UPDATE(unsigned int fwLen){
 		Serial.print((float)100*offset/fullLoops,0);//load percentage
 		Serial.println("%");
 
-		memcpy(chunkBuffer,(FW_IMG_Base_Controller + offset*chunkSize),chunkSize);	//copy image into buffer to send
 		while(!digitalRead(slaveAckPin));			//wait for Base Controller to be ready
-		spiSendRecvBuf(chunkBuffer,chunkSize);		//send chunk
+		spiSendGatherBuf(NULL,0,(FW_IMG_Base_Controller + offset*chunkSize),chunkSize);	//send chunk straight from the image
 
 
 	}
@@ -1526,9 +2090,8 @@ bool P1AM::Base_Controller_FW_UPDATE(unsigned int fwLen){
 	chunkSize = fwLen % chunkSize;	//get the remaining bytes smaller than 1 chunk
 	if(chunkSize != 0)
 	{
-		memcpy(chunkBuffer,(FW_IMG_Base_Controller + offset*chunkSize),chunkSize);	//copy image into buffer to send
 		while(!digitalRead(slaveAckPin));			//wait for Base Controller to be ready
-		spiSendRecvBuf(chunkBuffer,chunkSize);
+		spiSendGatherBuf(NULL,0,(FW_IMG_Base_Controller + offset*chunkSize),chunkSize);
 	}
 
 	Serial.println("100%");
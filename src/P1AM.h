@@ -31,12 +31,40 @@ SOFTWARE.
 #include "SPI.h"
 #include "Module_List.h"
 #include "defines.h"
+#include "P1_Block.h"
+#include "P1_Driver.h"
 
 struct channelLabel{			//Used to call functions through names rather than slot/channel numbers.
 	uint8_t slot;
 	uint8_t channel;
 };
 
+struct blockRegion{			//One region of a Base Controller data block. Used by readBlockSnapshot.
+	char *buf;					//Buffer that receives the data
+	uint16_t len;				//Number of bytes to read
+	uint16_t offset;			//Starting byte in the block
+	uint8_t type;				//DISCRETE_IN_BLOCK, ANALOG_IN_BLOCK, etc.
+};
+
+struct channelReading{		//Analog or temperature value with quality flags decoded from the same scan
+	union{
+		int counts;				//Value in counts for analog modules
+		float temperature;		//Value in degrees for temperature modules. NAN when quality is not good
+	};
+	uint8_t quality;			//QUALITY_GOOD or bitmapped QUALITY_ flags
+	uint32_t timestamp;			//micros() at the end of the scan the reading came from
+	uint32_t scanSequence;		//Base Controller scan the reading came from
+};
+
+struct burstStats{			//Result of readAnalogBurst
+	uint16_t samples;			//Samples taken
+	uint16_t repeatedScans;		//Samples that returned the same scan as the sample before
+	uint16_t skippedScans;		//Estimated scans that completed between samples and were never read
+	uint32_t scanPeriod;		//Base Controller scan time in microseconds, measured before the burst
+	uint32_t elapsed;			//Length of the burst in microseconds
+	uint32_t rate;				//Achieved samples per second
+};
+
 class P1AM{
 	public:
 	P1AM();
@@ -52,14 +80,27 @@ class P1AM{
 	int readAnalog(uint8_t slot, uint8_t channel);								//Read Analog Module. Returns 32 bits of data. 16/14/12/etc bit modules are not scaled and will return a bit appropriate value.
 	float readTemperature(uint8_t slot, uint8_t channel);						//Read Temperature Module. Returns float.
 	void writeAnalog(uint32_t data,uint8_t slot, uint8_t channel);				//Write Analog Module. Send up to 32 bits of data. 16/14/12/etc bit modules are masked on Base Controller
+	channelReading readAnalogQuality(uint8_t slot, uint8_t channel);			//Read Analog Module channel with its burnout/range/24V flags from the same scan
+	channelReading readTemperatureQuality(uint8_t slot, uint8_t channel);		//Read Temperature Module channel with quality flags. Temperature is NAN if not good
+	uint8_t readQuality(channelReading readings[], uint8_t slot);				//Read all channels of an Analog Module with quality flags. Returns number of channels
 	void readBlockData(char *buf, uint16_t len,uint16_t offset, uint8_t type);	//Read raw  data buffers. Allows for data updates for large numbers of points.
 	void writeBlockData(char *buf, uint16_t len,uint16_t offset, uint8_t type); //Write to raw data buffers. Allows for data updates for large numbers of points.
+	uint32_t readBlockSnapshot(blockRegion regions[], uint8_t numberOfRegions);	//Read several block regions from the same Base Controller scan. Returns the scan sequence number.
+	uint32_t getScanSequence();													//Returns the number of Base Controller scans snapshots were aligned to
+	uint32_t getScanTimestamp();												//Returns micros() at the end of the scan the last snapshot came from
+	burstStats readAnalogBurst(char buf[], uint32_t timestamps[], uint16_t samples, uint8_t slot, uint8_t firstChannel = 1, uint8_t count = 1);	//Read a window of Analog Input channels back to back as fast as possible
+	void setSyncPolicy(uint8_t policy);											//SYNC_STRICT, SYNC_DEFERRED or SYNC_NONE. See function header in P1AM.cpp
+	uint8_t getSyncPolicy();
+	void sync();																//Wait for pending writes to be scanned out. Used with SYNC_DEFERRED
 
 	//PWM Module functions - For more info see function headers in P1AM.cpp
 	void writePWM(float duty,uint32_t freq,uint8_t slot,uint8_t channel);		//Set duty cycle and frequency of a PWM module channel
 	void writePWMDuty(float duty,uint8_t slot,uint8_t channel);					//Set duty cycle of a PWM module channel without changing its frequency
 	void writePWMFreq(uint32_t freq,uint8_t slot,uint8_t channel);				//Set frequency of a PWM module channel without changing its duty cycle
 	void writePWMDir(bool data,uint8_t slot, uint8_t channel);					//Set state of PWM channel when configured for DIR mode
+	void writePWMFixed(uint16_t duty,uint32_t freq,uint8_t slot,uint8_t channel);	//Same as writePWM with duty in hundredths of a percent. 0-10000
+	void writePWMDutyFixed(uint16_t duty,uint8_t slot,uint8_t channel);				//Same as writePWMDuty with duty in hundredths of a percent. 0-10000
+	void writePWMFixed(const uint16_t duty[],const uint32_t freq[],uint8_t slot,uint8_t firstChannel,uint8_t count);	//Set several consecutive channels in one write
 
 	//Utility Functions - For more info see function headers in P1AM.cpp
 	uint8_t printModules();									//Print list of all signed on modules to the Serial monitor
@@ -81,6 +122,8 @@ class P1AM{
 	uint8_t checkConnection(uint8_t numberOfModules = 0);	//Checks the modules to see if a connection has been lost. Returns first missing module.
 	bool Base_Controller_FW_UPDATE(unsigned int fwLen);		//For FW update of Base Controller
 	moduleProps readSlotProps(uint8_t slot);                //Returns the module properties at the given slot location.
+	const P1_Driver *readSlotDriver(uint8_t slot);			//Returns the driver the module at the given slot was given at sign-on. NULL if empty
+	uint16_t blockOffset(uint8_t slot, uint8_t type);		//Returns the byte offset of a slot's data in a Base Controller data block
 	
 	//Label functions - functionally the same as the above Data IO but use the channelLabel datatype for easier to read code.
 	uint32_t readDiscrete(channelLabel label);
@@ -92,21 +135,36 @@ class P1AM{
 	void writePWMDuty(float duty, channelLabel label);
 	void writePWMFreq(uint32_t freq, channelLabel label);
 	void writePWMDir(bool data, channelLabel label);
+	void writePWMFixed(uint16_t duty, uint32_t freq, channelLabel label);
+	void writePWMDutyFixed(uint16_t duty, channelLabel label);
 	uint8_t checkUnderRange(channelLabel label);
 	uint8_t checkOverRange(channelLabel label);
 	uint8_t checkBurnout(channelLabel label);
+	channelReading readAnalogQuality(channelLabel label);
+	channelReading readTemperatureQuality(channelLabel label);
 
 	//Private functions for Base Controller communication.
 	private:
 	uint8_t spiSendRecvByte(uint8_t data);
 	uint32_t spiSendRecvInt(uint32_t data);
 	void spiSendRecvBuf(uint8_t *buf, int len,  bool returnData = 0);
+	void spiSendGatherBuf(const uint8_t *hdr, int hdrLen, const uint8_t *buf, int len);
 	bool spiTimeout(uint32_t uS, uint8_t resendMsg = 0,uint16_t retryPeriod = 0);
-	char *loadConfigBuf(int moduleID);
+	bool readBlockRaw(char buf[], uint16_t len, uint16_t offset, uint8_t type);
 	bool  handleHDR(uint8_t HDR);
-	void dataSync();
+	bool dataSync();
+	bool isFamily(uint8_t slot, uint8_t family);
+	void syncBeforeRead();
+	void syncAfterRead();
+	void syncBeforeWrite();
+	void syncAfterWrite();
+	uint8_t syncPolicy = SYNC_STRICT;
+	bool syncPending = false;		//A write has not been synced yet. Used by SYNC_DEFERRED
+	uint32_t scanSequence = 0;		//Incremented each time readBlockSnapshot aligns to a full Base Controller scan
+	uint32_t scanTimestamp = 0;		//micros() at the end of that scan
 	struct moduleInfo{
 		uint8_t dbLoc;			//mdb location
+		const P1_Driver *driver;	//Driver resolved at sign-on
 	}baseSlot[NUMBER_OF_MODULES];
 
 };
@@ -0,0 +1,85 @@
+/*
+MIT License
+
+Copyright (c) 2023 FACTS Engineering, LLC
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include "P1_Block.h"
+
+/*******************************************************************************
+Description: Decode a region of analog block data into counts. Each channel is
+			 copied into a word, which also covers unaligned buffers since the
+			 Cortex-M0+ can not load unaligned words, and byte swapped with a
+			 single REV instruction.
+
+Parameters: -const uint8_t *block - Block data read with readBlockData
+			-int32_t values[] - Array to store one value per channel
+			-uint16_t channels - Number of channels. block holds 4 bytes per channel
+
+Returns: 	-none
+*******************************************************************************/
+void decodeAnalogBlock(const uint8_t *block, int32_t values[], uint16_t channels){
+	uint32_t word = 0;
+
+	for(int i = 0; i < channels; i++){
+		memcpy(&word,block + 4*i,4);
+		values[i] = (int32_t)__builtin_bswap32(word);	//Block data is big endian
+	}
+}
+
+/*******************************************************************************
+Description: Decode a region of temperature module block data into floats. The
+			 registers hold the bits of a float in big endian byte order.
+
+Parameters: -const uint8_t *block - Block data read with readBlockData
+			-float values[] - Array to store one temperature per channel
+			-uint16_t channels - Number of channels. block holds 4 bytes per channel
+
+Returns: 	-none
+*******************************************************************************/
+void decodeTemperatureBlock(const uint8_t *block, float values[], uint16_t channels){
+	uint32_t word = 0;
+
+	for(int i = 0; i < channels; i++){
+		memcpy(&word,block + 4*i,4);
+		word = __builtin_bswap32(word);
+		memcpy(&values[i],&word,4);		//Same bits as a float
+	}
+}
+
+/*******************************************************************************
+Description: Encode counts into a region of analog output block data ready for
+			 writeBlockData.
+
+Parameters: -const int32_t values[] - One value per channel
+			-uint8_t *block - Buffer to store 4 bytes per channel
+			-uint16_t channels - Number of channels
+
+Returns: 	-none
+*******************************************************************************/
+void encodeAnalogBlock(const int32_t values[], uint8_t *block, uint16_t channels){
+	uint32_t word = 0;
+
+	for(int i = 0; i < channels; i++){
+		word = __builtin_bswap32((uint32_t)values[i]);	//Block data is big endian
+		memcpy(block + 4*i,&word,4);
+	}
+}
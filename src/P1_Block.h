@@ -0,0 +1,36 @@
+/*
+MIT License
+
+Copyright (c) 2023 FACTS Engineering, LLC
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef P1_Block_h
+#define P1_Block_h
+
+#include "Arduino.h"
+
+//Block Kernels - Convert whole regions of ANALOG_IN_BLOCK and ANALOG_OUT_BLOCK data.
+//Each channel is one big endian 32 bit register. For more info see function headers in P1_Block.cpp
+void decodeAnalogBlock(const uint8_t *block, int32_t values[], uint16_t channels);		//Big endian bytes to counts
+void decodeTemperatureBlock(const uint8_t *block, float values[], uint16_t channels);	//Big endian bytes to floats
+void encodeAnalogBlock(const int32_t values[], uint8_t *block, uint16_t channels);		//Counts to big endian bytes
+
+#endif
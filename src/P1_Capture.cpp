@@ -0,0 +1,372 @@
+/*
+MIT License
+
+Copyright (c) 2023 FACTS Engineering, LLC
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include "P1_Capture.h"
+
+/*******************************************************************************
+Description: Constructor for P1_Capture class. Records selected channels of a
+			 P1_Scan into a circular history every scan. When the capture is
+			 armed and the trigger fires, the samples before and after the
+			 trigger are frozen in a second buffer that can be read out while
+			 the history keeps recording, so nothing is missed around an
+			 intermittent fault. Both buffers use about 6kB of RAM.
+
+Parameters: -P1_Scan &scan - Scan holding the input image
+
+Returns: 	-none
+
+Example Code: 
+*******************************************************************************/
+P1_Capture::P1_Capture(P1_Scan &scan){
+
+	this->scan = &scan;
+	memset(table,0,sizeof(table));
+	memset(buffers,0,sizeof(buffers));
+
+}
+
+/*******************************************************************************
+Description: Record a channel in the capture. Discrete input channels are
+			 recorded as 0 or 1, analog channels in counts and temperature
+			 channels in degrees.
+
+Parameters: -uint8_t slot - Slot of the module. Slots start at 1.
+			-uint8_t channel - Channel of the module. Channels start at 1.
+
+Returns: 	-int8_t - Index of the channel. -1 on failure.
+
+Example Code: 
+*******************************************************************************/
+int8_t P1_Capture::addChannel(uint8_t slot, uint8_t channel){
+	slotImage *image = NULL;
+	uint8_t family = DRIVER_NONE;
+	bool valid = false;
+
+	if(count >= CAPTURE_CHANNELS){
+		debugPrintln("No room for another channel");
+		return -1;
+	}
+
+	image = scan->getSlot(slot);
+	if((image != NULL) && (image->driver != NULL)){
+		family = image->driver->family();
+	}
+
+	switch(family){
+		case DRIVER_DISCRETE:
+			valid = scan->discreteChannel(slot,channel).valid() && (channel <= (image->props.diBytes * 8));
+			break;
+		case DRIVER_TEMPERATURE:
+			valid = scan->temperatureChannel(slot,channel).valid() && (channel <= (image->props.aiBytes / 4));
+			break;
+		default:
+			valid = scan->analogChannel(slot,channel).valid() && (channel <= (image->props.aiBytes / 4));
+			break;
+	}
+	if(!valid){
+		debugPrintln("This channel can not be captured");
+		return -1;
+	}
+
+	table[count].image = image;
+	table[count].index = channel - 1;
+	table[count].family = family;
+	table[count].mask = 1 << (channel - 1);
+	return count++;
+}
+
+/*******************************************************************************
+Description: Trigger on the value of a captured channel. Level triggers fire
+			 on any scan the value is past the level. Edge triggers only fire
+			 on the scan the value crosses the level. Samples flagged
+			 QUALITY_NO_DATA are never used.
+
+Parameters: -uint8_t index - Index returned by addChannel
+			-uint8_t type - TRIGGER_ABOVE, TRIGGER_BELOW, TRIGGER_RISING,
+			 TRIGGER_FALLING or TRIGGER_NONE
+			-float level - Trigger level in counts, degrees or 0/1 for
+			 discrete channels. e.g. TRIGGER_RISING with level 0 fires when a
+			 discrete input turns on.
+
+Returns: 	-bool - false if the channel or type is not valid
+
+Example Code: 
+*******************************************************************************/
+bool P1_Capture::setTrigger(uint8_t index, uint8_t type, float level){
+
+	if((index >= count) || (type > TRIGGER_FALLING)){
+		debugPrintln("Trigger is not valid");
+		return false;
+	}
+	triggerType = type;
+	triggerIndex = index;
+	triggerLevel = level;
+	haveLast = false;
+	return true;
+}
+
+/*******************************************************************************
+Description: Trigger when any of the quality flags in the mask are set on a
+			 captured analog or temperature channel, e.g. on burnout or when the
+			 module loses 24V.
+
+Parameters: -uint8_t index - Index returned by addChannel
+			-uint8_t qualityMask - QUALITY_BURNOUT, QUALITY_UNDER_RANGE,
+			 QUALITY_OVER_RANGE and QUALITY_MISSING_24V or'd together
+
+Returns: 	-bool - false if the channel does not report quality flags
+
+Example Code: 
+*******************************************************************************/
+bool P1_Capture::setStatusTrigger(uint8_t index, uint8_t qualityMask){
+
+	if((index >= count) || (table[index].family == DRIVER_DISCRETE) || (qualityMask == 0)){
+		debugPrintln("Trigger is not valid");
+		return false;
+	}
+	triggerType = TRIGGER_STATUS;
+	triggerIndex = index;
+	triggerMask = qualityMask;
+	return true;
+}
+
+/*******************************************************************************
+Description: Wait for the trigger. The trigger is checked on every scan and
+			 may fire right away, in which case fewer pre trigger samples are
+			 kept if the history is not yet that long.
+
+Parameters: -uint16_t preSamples - Samples to keep before the trigger
+			-uint16_t postSamples - Samples to keep after the trigger
+
+Returns: 	-bool - false if preSamples + postSamples + 1 is more than CAPTURE_DEPTH
+
+Example Code: 
+*******************************************************************************/
+bool P1_Capture::arm(uint16_t preSamples, uint16_t postSamples){
+
+	if((preSamples + postSamples) >= CAPTURE_DEPTH){
+		debugPrint("Capture can hold at most ");
+		debugPrint(CAPTURE_DEPTH);
+		debugPrintln(" samples");
+		return false;
+	}
+	this->preSamples = preSamples;
+	this->postSamples = postSamples;
+	forceTrigger = false;
+	haveLast = false;
+	state = CAPTURE_ARMED;
+	return true;
+}
+
+void P1_Capture::disarm(void){
+
+	if((state == CAPTURE_ARMED) || (state == CAPTURE_TRIGGERED)){
+		state = CAPTURE_IDLE;
+	}
+
+}
+
+void P1_Capture::trigger(void){
+
+	forceTrigger = (state == CAPTURE_ARMED);
+
+}
+
+/*******************************************************************************
+Description: Record the latest scan and check the trigger. This is a copy of
+			 each captured register and one compare, so it can run every scan.
+
+Parameters: -none
+
+Returns: 	-none
+
+Example Code: 
+*******************************************************************************/
+void P1_Capture::update(void){
+	captureSample *sample;
+	captureChannel *channel;
+
+	if(!scan->isNewScan(lastSequence)){
+		return;
+	}
+
+	sample = &buffers[live][head];
+	sample->timestamp = scan->timestamp;
+	sample->scanSequence = scan->scanSequence;
+	for(int i = 0; i < count; i++){
+		channel = &table[i];
+		if(channel->family == DRIVER_DISCRETE){
+			sample->values[i] = (channel->image->inputs & channel->mask) ? 1 : 0;
+			sample->quality[i] = QUALITY_GOOD;
+		}
+		else{
+			sample->values[i] = channel->image->inputValues[channel->index];
+			sample->quality[i] = channel->image->quality[channel->index];
+		}
+	}
+	head = (head + 1) % CAPTURE_DEPTH;
+	if(filled < CAPTURE_DEPTH){
+		filled++;
+	}
+
+	if(state == CAPTURE_TRIGGERED){
+		remaining--;
+	}
+	else if((state == CAPTURE_ARMED) && checkTrigger(*sample)){
+		state = CAPTURE_TRIGGERED;
+		preCount = (filled - 1 < preSamples) ? filled - 1 : preSamples;
+		remaining = postSamples;
+	}
+
+	if((state == CAPTURE_TRIGGERED) && (remaining == 0)){
+		freeze();
+	}
+}
+
+uint8_t P1_Capture::getState(void){
+
+	return state;
+
+}
+
+bool P1_Capture::captureDone(void){
+	bool wasDone = done;
+
+	done = false;
+	return wasDone;
+}
+
+uint16_t P1_Capture::samples(void){
+
+	return frozenCount;
+
+}
+
+uint16_t P1_Capture::triggerSample(void){
+
+	return frozenTrigger;
+
+}
+
+float P1_Capture::read(uint16_t sample, uint8_t index){
+	const captureSample *data = frozenSample(sample);
+
+	if((data == NULL) || (index >= count)){
+		return 0;
+	}
+	return value(index,data->values[index]);
+}
+
+uint8_t P1_Capture::quality(uint16_t sample, uint8_t index){
+	const captureSample *data = frozenSample(sample);
+
+	if((data == NULL) || (index >= count)){
+		return QUALITY_NO_DATA;
+	}
+	return data->quality[index];
+}
+
+uint32_t P1_Capture::readTimestamp(uint16_t sample){
+	const captureSample *data = frozenSample(sample);
+
+	return (data != NULL) ? data->timestamp : 0;
+}
+
+uint32_t P1_Capture::readSequence(uint16_t sample){
+	const captureSample *data = frozenSample(sample);
+
+	return (data != NULL) ? data->scanSequence : 0;
+}
+
+bool P1_Capture::checkTrigger(const captureSample &sample){
+	float current = 0;
+	float previous = lastValue;
+	bool hadLast = haveLast;
+
+	if(forceTrigger){
+		forceTrigger = false;
+		return true;
+	}
+	if((triggerType == TRIGGER_NONE) || (count == 0)){
+		return false;
+	}
+	if(triggerType == TRIGGER_STATUS){
+		return (sample.quality[triggerIndex] & triggerMask) != 0;
+	}
+	if(sample.quality[triggerIndex] & QUALITY_NO_DATA){
+		return false;
+	}
+
+	current = value(triggerIndex,sample.values[triggerIndex]);
+	lastValue = current;
+	haveLast = true;
+
+	switch(triggerType){
+		case TRIGGER_ABOVE:
+			return current > triggerLevel;
+		case TRIGGER_BELOW:
+			return current < triggerLevel;
+		case TRIGGER_RISING:
+			return hadLast && (previous <= triggerLevel) && (current > triggerLevel);
+		case TRIGGER_FALLING:
+			return hadLast && (previous >= triggerLevel) && (current < triggerLevel);
+		default:
+			return false;
+	}
+}
+
+float P1_Capture::value(uint8_t index, uint32_t data){
+	union int2float{
+		uint32_t data;
+		float value;
+	}converted;
+
+	if(table[index].family == DRIVER_TEMPERATURE){
+		converted.data = data;
+		return converted.value;
+	}
+	return (float)(int32_t)data;
+}
+
+void P1_Capture::freeze(void){
+
+	frozen = live;
+	frozenCount = preCount + 1 + postSamples;
+	frozenStart = (head + CAPTURE_DEPTH - frozenCount) % CAPTURE_DEPTH;
+	frozenTrigger = preCount;
+
+	live ^= 1;			//Keep recording in the other buffer
+	head = 0;
+	filled = 0;
+	state = CAPTURE_DONE;
+	done = true;
+}
+
+const captureSample *P1_Capture::frozenSample(uint16_t sample){
+
+	if(sample >= frozenCount){
+		return NULL;
+	}
+	return &buffers[frozen][(frozenStart + sample) % CAPTURE_DEPTH];
+}
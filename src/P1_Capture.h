@@ -0,0 +1,120 @@
+/*
+MIT License
+
+Copyright (c) 2023 FACTS Engineering, LLC
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef P1_Capture_h
+#define P1_Capture_h
+
+#include "P1AM.h"
+#include "P1_Scan.h"
+
+#define CAPTURE_CHANNELS	8		//Maximum number of channels recorded per capture
+#define CAPTURE_DEPTH		64		//Samples per buffer. Pre and post trigger samples plus the trigger must fit
+
+#define TRIGGER_NONE		0		//Only trigger() starts the capture
+#define TRIGGER_ABOVE		1		//Level. Value is above the trigger level
+#define TRIGGER_BELOW		2		//Level. Value is below the trigger level
+#define TRIGGER_RISING		3		//Edge. Value crosses the trigger level going up
+#define TRIGGER_FALLING		4		//Edge. Value crosses the trigger level going down
+#define TRIGGER_STATUS		5		//Any of the QUALITY_ flags in the mask is set
+
+#define CAPTURE_IDLE		0		//Recording history, not armed
+#define CAPTURE_ARMED		1		//Waiting for the trigger
+#define CAPTURE_TRIGGERED	2		//Recording post trigger samples
+#define CAPTURE_DONE		3		//Capture frozen and ready to read
+
+struct captureSample{			//One scan of every captured channel
+	uint32_t timestamp;			//micros() of the scan
+	uint32_t scanSequence;
+	uint32_t values[CAPTURE_CHANNELS];	//Counts, float bits or 0/1 for discrete channels
+	uint8_t quality[CAPTURE_CHANNELS];
+};
+
+class P1_Capture{
+
+	public:
+	P1_Capture(P1_Scan &scan);
+
+	//Setup - Returns the index of the channel or -1 on failure. Call after scan.begin()
+	int8_t addChannel(uint8_t slot, uint8_t channel);		//Discrete input, analog or temperature channel
+	bool setTrigger(uint8_t index, uint8_t type, float level = 0);	//TRIGGER_ABOVE, BELOW, RISING or FALLING
+	bool setStatusTrigger(uint8_t index, uint8_t qualityMask);		//e.g. QUALITY_BURNOUT | QUALITY_MISSING_24V
+	bool arm(uint16_t preSamples, uint16_t postSamples);	//Wait for the trigger. Returns false if the samples do not fit
+	void disarm(void);
+	void trigger(void);				//Trigger on the next scan if armed
+
+	//Scan Functions
+	void update(void);				//Record the latest scan and check the trigger. Call after scan.update()
+	uint8_t getState(void);			//CAPTURE_IDLE, ARMED, TRIGGERED or DONE
+	bool captureDone(void);			//true once per completed capture
+
+	//Frozen Capture - Kept until the next capture completes. Sample 0 is the oldest
+	uint16_t samples(void);			//Number of samples in the frozen capture
+	uint16_t triggerSample(void);	//Sample the trigger happened on
+	float read(uint16_t sample, uint8_t index);		//Counts, degrees or 0/1
+	uint8_t quality(uint16_t sample, uint8_t index);
+	uint32_t readTimestamp(uint16_t sample);
+	uint32_t readSequence(uint16_t sample);
+
+	private:
+	struct captureChannel{
+		slotImage *image;
+		uint8_t index;				//Register in the slot image
+		uint8_t family;				//DRIVER_DISCRETE, DRIVER_ANALOG or DRIVER_TEMPERATURE
+		uint16_t mask;				//Input bit for discrete channels
+	}table[CAPTURE_CHANNELS];
+	captureSample buffers[2][CAPTURE_DEPTH];
+	P1_Scan *scan;
+	uint8_t count = 0;
+	uint32_t lastSequence = 0;
+
+	uint8_t live = 0;				//Buffer being recorded
+	uint16_t head = 0;				//Next sample written in the live buffer
+	uint16_t filled = 0;			//Samples of history in the live buffer
+
+	uint8_t state = CAPTURE_IDLE;
+	bool done = false;
+	bool forceTrigger = false;
+	uint8_t triggerType = TRIGGER_NONE;
+	uint8_t triggerIndex = 0;
+	float triggerLevel = 0;
+	uint8_t triggerMask = 0;
+	bool haveLast = false;
+	float lastValue = 0;			//Trigger channel on the previous scan. Used by edge triggers
+	uint16_t preSamples = 0;
+	uint16_t postSamples = 0;
+	uint16_t preCount = 0;			//Pre trigger samples actually recorded
+	uint16_t remaining = 0;			//Post trigger samples still to record
+
+	uint8_t frozen = 1;				//Buffer holding the last capture
+	uint16_t frozenStart = 0;
+	uint16_t frozenCount = 0;
+	uint16_t frozenTrigger = 0;
+
+	bool checkTrigger(const captureSample &sample);
+	float value(uint8_t index, uint32_t data);
+	void freeze(void);
+	const captureSample *frozenSample(uint16_t sample);
+};
+
+#endif
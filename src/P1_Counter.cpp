@@ -0,0 +1,170 @@
+/*
+MIT License
+
+Copyright (c) 2023 FACTS Engineering, LLC
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include "P1_Counter.h"
+
+/*******************************************************************************
+Description: Constructor for P1_Counter class. Counts pulses on ordinary discrete
+			 inputs using the scans of a P1_Image. The edges of every point in
+			 the base are found together with word operations, then each
+			 counter adds the edges of its point. The time between scans is
+			 measured so the highest countable rate is known.
+
+Parameters: -P1_Image &image - Image holding the discrete inputs
+
+Returns: 	-none
+
+Example Code: 
+*******************************************************************************/
+P1_Counter::P1_Counter(P1_Image &image){
+
+	this->image = &image;
+	memset(table,0,sizeof(table));
+	memset(rising,0,sizeof(rising));
+	memset(falling,0,sizeof(falling));
+	memset(previous,0,sizeof(previous));
+
+}
+
+/*******************************************************************************
+Description: Attach a counter to a discrete input point.
+
+Parameters: -uint16_t point - Global point index from image.inputPoint
+			-uint8_t edges - COUNT_RISING, COUNT_FALLING or COUNT_BOTH
+			-bool countDown - true to count down instead of up
+
+Returns: 	-int8_t - Index of the counter. -1 on failure.
+
+Example Code: 
+*******************************************************************************/
+int8_t P1_Counter::addCounter(uint16_t point, uint8_t edges, bool countDown){
+
+	if(count >= COUNTER_CHANNELS){
+		debugPrintln("No room for another counter");
+		return -1;
+	}
+	if((point >= IMAGE_DISCRETE_WORDS * 32) || ((edges & COUNT_BOTH) == 0)){
+		debugPrintln("This channel is not valid");
+		return -1;
+	}
+
+	table[count].point = point;
+	table[count].edges = edges & COUNT_BOTH;
+	table[count].countDown = countDown;
+	table[count].count = 0;
+	return count++;
+}
+
+void P1_Counter::preset(uint8_t index, int32_t value){
+
+	if(index < count){
+		table[index].count = value;
+	}
+
+}
+
+void P1_Counter::setDirection(uint8_t index, bool countDown){
+
+	if(index < count){
+		table[index].countDown = countDown;
+	}
+
+}
+
+int32_t P1_Counter::read(uint8_t index){
+
+	return (index < count) ? table[index].count : 0;
+
+}
+
+/*******************************************************************************
+Description: Find the edges between the last two scans of the image and add them
+			 to the counters.
+
+Parameters: -none
+
+Returns: 	-none
+
+Example Code: 
+*******************************************************************************/
+void P1_Counter::update(void){
+	uint32_t period = 0;
+	uint32_t mask = 0;
+	uint8_t word = 0;
+	int8_t edgesSeen = 0;
+
+	if(!image->isNewScan(lastSequence)){
+		return;
+	}
+
+	if(!primed){
+		memcpy(previous,image->inputs,sizeof(previous));
+		lastTimestamp = image->timestamp;
+		primed = true;
+		return;
+	}
+
+	period = image->timestamp - lastTimestamp;
+	lastTimestamp = image->timestamp;
+	scanPeriod = (scanPeriod == 0) ? period : scanPeriod + (((int32_t)(period - scanPeriod)) / 8);
+	maxScanPeriod = (period > maxScanPeriod) ? period : maxScanPeriod;
+
+	for(int w = 0; w < IMAGE_DISCRETE_WORDS; w++){
+		rising[w] = image->inputs[w] & ~previous[w];
+		falling[w] = ~image->inputs[w] & previous[w];
+		previous[w] = image->inputs[w];
+	}
+
+	for(int i = 0; i < count; i++){
+		word = table[i].point >> 5;
+		mask = 1UL << (table[i].point & 0x1F);
+		edgesSeen = 0;
+		if((table[i].edges & COUNT_RISING) && (rising[word] & mask)){
+			edgesSeen++;
+		}
+		if((table[i].edges & COUNT_FALLING) && (falling[word] & mask)){
+			edgesSeen++;
+		}
+		table[i].count += table[i].countDown ? -edgesSeen : edgesSeen;
+	}
+}
+
+/*******************************************************************************
+Description: Highest pulse rate that can be counted without missing pulses at
+			 the longest scan period seen. A pulse has to be on for at least
+			 one scan and off for at least one scan.
+
+Parameters: -none
+
+Returns: 	-uint32_t - Pulses per second. 0 until two scans have been seen.
+
+Example Code: 
+*******************************************************************************/
+uint32_t P1_Counter::maxRate(void){
+
+	if(maxScanPeriod == 0){
+		return 0;
+	}
+	return 1000000UL / (2 * maxScanPeriod);
+}
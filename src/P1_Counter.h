@@ -0,0 +1,73 @@
+/*
+MIT License
+
+Copyright (c) 2023 FACTS Engineering, LLC
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef P1_Counter_h
+#define P1_Counter_h
+
+#include "P1AM.h"
+#include "P1_Image.h"
+
+#define COUNTER_CHANNELS 16		//Maximum number of counters per counter bank
+
+#define COUNT_RISING	1		//Count off to on transitions
+#define COUNT_FALLING	2		//Count on to off transitions
+#define COUNT_BOTH		3		//Count every transition
+
+class P1_Counter{
+
+	public:
+	P1_Counter(P1_Image &image);
+
+	//Setup - Returns the index of the counter or -1 on failure
+	int8_t addCounter(uint16_t point, uint8_t edges = COUNT_RISING, bool countDown = false);	//Point from image.inputPoint
+	void preset(uint8_t index, int32_t value);
+	void setDirection(uint8_t index, bool countDown);
+
+	//Scan Functions
+	void update(void);				//Find the edges of the latest scan and count them. Call after image.update()
+	int32_t read(uint8_t index);
+	uint32_t rising[IMAGE_DISCRETE_WORDS];		//Points that turned on in the last scan
+	uint32_t falling[IMAGE_DISCRETE_WORDS];		//Points that turned off in the last scan
+
+	//Rate - A pulse must be seen on for one scan and off for one scan to be counted
+	uint32_t scanPeriod = 0;		//Average microseconds between scans
+	uint32_t maxScanPeriod = 0;		//Longest microseconds between scans. Write 0 to restart
+	uint32_t maxRate(void);			//Highest pulse rate in Hz that can be counted without missing pulses
+
+	private:
+	struct softCounter{
+		uint16_t point;
+		uint8_t edges;
+		bool countDown;
+		int32_t count;
+	}table[COUNTER_CHANNELS];
+	P1_Image *image;
+	uint8_t count = 0;
+	uint32_t previous[IMAGE_DISCRETE_WORDS];
+	uint32_t lastSequence = 0;
+	uint32_t lastTimestamp = 0;
+	bool primed = false;
+};
+
+#endif
@@ -0,0 +1,165 @@
+/*
+MIT License
+
+Copyright (c) 2023 FACTS Engineering, LLC
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include "P1_Debounce.h"
+
+/*******************************************************************************
+Description: Constructor for P1_Debounce class. Debounces every discrete input
+			 of a P1_Image with vertical counters. Each point has a small counter
+			 whose bits are spread across DEBOUNCE_PLANES words, so 32 points are
+			 counted, compared and switched with a handful of word operations per
+			 scan no matter how many points are in the base.
+
+			 A point changes state once its input has differed from the
+			 debounced state for its on time (turning on) or off time (turning
+			 off) in consecutive scans. Filter time in ms is scans times the
+			 scan period. Every point starts with a filter of 1 scan.
+
+Parameters: -P1_Image &image - Image holding the raw discrete inputs
+
+Returns: 	-none
+
+Example Code: 
+*******************************************************************************/
+P1_Debounce::P1_Debounce(P1_Image &image){
+
+	this->image = &image;
+	memset(inputs,0,sizeof(inputs));
+	memset(counters,0,sizeof(counters));
+	memset(onLimit,0,sizeof(onLimit));
+	memset(offLimit,0,sizeof(offLimit));
+
+}
+
+/*******************************************************************************
+Description: Set the on and off filter times of points.
+
+Parameters: -uint16_t point - Global point index from image.inputPoint
+			-uint8_t word - Index of the 32 point word. Word 0 holds points 0-31
+			-uint32_t mask - Points of the word to set
+			-uint8_t onScans - Scans an input must stay on before it turns on. 1-16
+			-uint8_t offScans - Scans an input must stay off before it turns off. 1-16
+
+Returns: 	-none
+
+Example Code: 
+*******************************************************************************/
+void P1_Debounce::setFilter(uint8_t onScans, uint8_t offScans){
+
+	for(int i = 0; i < IMAGE_DISCRETE_WORDS; i++){
+		setFilter(i,0xFFFFFFFF,onScans,offScans);
+	}
+
+}
+
+void P1_Debounce::setFilter(uint16_t point, uint8_t onScans, uint8_t offScans){
+
+	setFilter(point >> 5,1UL << (point & 0x1F),onScans,offScans);
+
+}
+
+void P1_Debounce::setFilter(uint8_t word, uint32_t mask, uint8_t onScans, uint8_t offScans){
+
+	if(word >= IMAGE_DISCRETE_WORDS){
+		return;
+	}
+	onScans = (onScans < 1) ? 1 : ((onScans > DEBOUNCE_MAX_SCANS) ? DEBOUNCE_MAX_SCANS : onScans);
+	offScans = (offScans < 1) ? 1 : ((offScans > DEBOUNCE_MAX_SCANS) ? DEBOUNCE_MAX_SCANS : offScans);
+
+	for(int k = 0; k < DEBOUNCE_PLANES; k++){
+		onLimit[k][word] = (((onScans - 1) >> k) & 1) ? (onLimit[k][word] | mask) : (onLimit[k][word] & ~mask);
+		offLimit[k][word] = (((offScans - 1) >> k) & 1) ? (offLimit[k][word] | mask) : (offLimit[k][word] & ~mask);
+	}
+}
+
+/*******************************************************************************
+Description: Debounce the latest scan of the image. The first scan is taken
+			 as the debounced state.
+
+Parameters: -none
+
+Returns: 	-none
+
+Example Code: 
+*******************************************************************************/
+void P1_Debounce::update(void){
+	uint32_t raw = 0;
+	uint32_t state = 0;
+	uint32_t differ = 0;
+	uint32_t reached = 0;
+	uint32_t limit = 0;
+	uint32_t keep = 0;
+	uint32_t carry = 0;
+	uint32_t count = 0;
+
+	if(!image->isNewScan(lastSequence)){
+		return;
+	}
+
+	if(!primed){
+		memcpy(inputs,image->inputs,sizeof(inputs));
+		primed = true;
+		return;
+	}
+
+	for(int w = 0; w < IMAGE_DISCRETE_WORDS; w++){
+		raw = image->inputs[w];
+		state = inputs[w];
+		differ = raw ^ state;
+
+		reached = differ;			//Points whose count has reached their limit
+		for(int k = 0; k < DEBOUNCE_PLANES; k++){
+			limit = (state & offLimit[k][w]) | (~state & onLimit[k][w]);
+			reached &= ~(counters[k][w] ^ limit);
+		}
+		inputs[w] = state ^ reached;
+
+		keep = differ & ~reached;	//Count points still differing. Clear the rest
+		carry = keep;
+		for(int k = 0; k < DEBOUNCE_PLANES; k++){
+			count = counters[k][w] & keep;
+			counters[k][w] = count ^ carry;
+			carry &= count;
+		}
+	}
+}
+
+/*******************************************************************************
+Description: Read the debounced state of a point. Points past the end of the
+			 image read as off.
+
+Parameters: -uint16_t point - Global point index. Same numbering as P1_Image
+
+Returns: 	-bool - Debounced state of the point
+
+Example Code: 
+*******************************************************************************/
+bool P1_Debounce::readInput(uint16_t point){
+
+	if((point >> 5) >= IMAGE_DISCRETE_WORDS){
+		return false;
+	}
+	return (inputs[point >> 5] >> (point & 0x1F)) & 1;
+
+}
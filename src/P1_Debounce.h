@@ -0,0 +1,58 @@
+/*
+MIT License
+
+Copyright (c) 2023 FACTS Engineering, LLC
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef P1_Debounce_h
+#define P1_Debounce_h
+
+#include "P1AM.h"
+#include "P1_Image.h"
+
+#define DEBOUNCE_PLANES		4							//Bits in each vertical counter
+#define DEBOUNCE_MAX_SCANS	(1 << DEBOUNCE_PLANES)		//Longest filter time in scans
+
+class P1_Debounce{
+
+	public:
+	P1_Debounce(P1_Image &image);
+
+	//Setup - Filter times are in scans. 1 passes changes through on the first scan. 1-16
+	void setFilter(uint8_t onScans, uint8_t offScans);							//Every point in the base
+	void setFilter(uint16_t point, uint8_t onScans, uint8_t offScans);			//One point
+	void setFilter(uint8_t word, uint32_t mask, uint8_t onScans, uint8_t offScans);	//Points set in mask
+
+	//Scan Functions
+	void update(void);				//Debounce the latest scan of the image. Call after image.update()
+	bool readInput(uint16_t point);
+	uint32_t inputs[IMAGE_DISCRETE_WORDS];		//Debounced inputs. Same point numbering as P1_Image
+
+	private:
+	P1_Image *image;
+	uint32_t counters[DEBOUNCE_PLANES][IMAGE_DISCRETE_WORDS];	//Bit sliced count of scans each point has differed
+	uint32_t onLimit[DEBOUNCE_PLANES][IMAGE_DISCRETE_WORDS];	//Bit sliced on time - 1
+	uint32_t offLimit[DEBOUNCE_PLANES][IMAGE_DISCRETE_WORDS];	//Bit sliced off time - 1
+	uint32_t lastSequence = 0;
+	bool primed = false;
+};
+
+#endif
@@ -0,0 +1,228 @@
+/*
+MIT License
+
+Copyright (c) 2023 FACTS Engineering, LLC
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include "P1_Driver.h"
+#include "P1_Block.h"
+
+const P1_DiscreteDriver discreteDriver = P1_DiscreteDriver();
+const P1_AnalogDriver analogDriver = P1_AnalogDriver();
+const P1_TemperatureDriver temperatureDriver = P1_TemperatureDriver();
+const P1_PWMDriver pwmDriver = P1_PWMDriver();
+const P1_HSCDriver hscDriver = P1_HSCDriver();
+
+/*******************************************************************************
+Description: Discrete driver. Block data is a little endian bitmap of up to
+			 16 points.
+*******************************************************************************/
+uint8_t P1_DiscreteDriver::family(void) const{
+
+	return DRIVER_DISCRETE;
+
+}
+
+void P1_DiscreteDriver::decode(slotImage &image, const uint8_t *di, const uint8_t *ai, const uint8_t *status) const{
+	(void)ai;
+	(void)status;
+
+	if(image.props.diBytes > 0){
+		image.inputs = di[0];
+	}
+	if(image.props.diBytes > 1){
+		image.inputs |= (uint16_t)di[1] << 8;
+	}
+
+}
+
+uint8_t P1_DiscreteDriver::encode(const slotImage &image, uint8_t type, uint8_t *data) const{
+	uint8_t len = image.props.doBytes;
+
+	if(type != DISCRETE_OUT_BLOCK){
+		return 0;
+	}
+	for(int i = 0; i < len; i++){
+		data[i] = (image.outputs >> (8 * i)) & 0xFF;
+	}
+	return len;
+}
+
+/*******************************************************************************
+Description: Analog driver. Block data is one big endian 32 bit register per
+			 channel. Quality flags come from the module's status bytes.
+*******************************************************************************/
+uint8_t P1_AnalogDriver::family(void) const{
+
+	return DRIVER_ANALOG;
+
+}
+
+void P1_AnalogDriver::decode(slotImage &image, const uint8_t *di, const uint8_t *ai, const uint8_t *status) const{
+	uint8_t channels = image.props.aiBytes / 4;
+	uint8_t stLen = image.props.statusBytes;
+	uint8_t quality = 0;
+	(void)di;
+
+	decodeAnalogBlock(ai,(int32_t *)image.inputValues,channels);
+	for(int i = 0; i < channels; i++){
+		quality = QUALITY_GOOD;
+		if(stLen > BURNOUT_STATUS){
+			quality |= ((status[BURNOUT_STATUS] >> i) & 1) ? QUALITY_BURNOUT : 0;
+		}
+		if(stLen > UNDER_RANGE_STATUS){
+			quality |= ((status[UNDER_RANGE_STATUS] >> i) & 1) ? QUALITY_UNDER_RANGE : 0;
+		}
+		if(stLen > OVER_RANGE_STATUS){
+			quality |= ((status[OVER_RANGE_STATUS] >> i) & 1) ? QUALITY_OVER_RANGE : 0;
+		}
+		if(stLen > MISSING24V_STATUS){
+			quality |= ((status[MISSING24V_STATUS] >> 1) & 1) ? QUALITY_MISSING_24V : 0;
+		}
+		image.quality[i] = quality;
+	}
+}
+
+uint8_t P1_AnalogDriver::encode(const slotImage &image, uint8_t type, uint8_t *data) const{
+	uint8_t len = image.props.aoBytes;
+
+	if(type != ANALOG_OUT_BLOCK){
+		return 0;
+	}
+	encodeAnalogBlock((const int32_t *)image.outputValues,data,len / 4);
+	return len;
+}
+
+uint8_t P1_TemperatureDriver::family(void) const{
+
+	return DRIVER_TEMPERATURE;
+
+}
+
+uint8_t P1_PWMDriver::family(void) const{
+
+	return DRIVER_PWM;
+
+}
+
+/*******************************************************************************
+Description: High speed counter driver. Decodes the position and alert registers
+			 and the input status bits. The output registers are left to
+			 P1_HSC_Module so the scan never overwrites its configuration.
+*******************************************************************************/
+uint8_t P1_HSCDriver::family(void) const{
+
+	return DRIVER_HSC;
+
+}
+
+void P1_HSCDriver::decode(slotImage &image, const uint8_t *di, const uint8_t *ai, const uint8_t *status) const{
+	uint8_t channels = image.props.aiBytes / 4;
+	(void)status;
+
+	decodeAnalogBlock(ai,(int32_t *)image.inputValues,channels);
+	for(int i = 0; i < channels; i++){
+		image.quality[i] = QUALITY_GOOD;
+	}
+	image.inputs = di[0];
+}
+
+uint8_t P1_HSCDriver::encode(const slotImage &image, uint8_t type, uint8_t *data) const{
+	(void)image;
+	(void)type;
+	(void)data;
+
+	return 0;
+}
+
+static const moduleDriver moduleDrivers[] = {	//Modules that need a driver other than the one their block sizes suggest, or a configuration
+	{0x34605581, NULL, P1_04AD_DEFAULT_CONFIG},						//P1-04AD
+	{0x34605582, NULL, P1_04AD_1_DEFAULT_CONFIG},					//P1-04AD-1
+	{0x34605583, NULL, P1_04AD_2_DEFAULT_CONFIG},					//P1-04AD-2
+	{0x3460558F, NULL, P1_04ADL_1_DEFAULT_CONFIG},					//P1-04ADL-1
+	{0x34605590, NULL, P1_04ADL_2_DEFAULT_CONFIG},					//P1-04ADL-2
+	{0x34A0558A, NULL, P1_08ADL_1_DEFAULT_CONFIG},					//P1-08ADL-1
+	{0x34A0558B, NULL, P1_08ADL_2_DEFAULT_CONFIG},					//P1-08ADL-2
+	{0x5461A783, NULL, P1_04ADL2DAL_1_DEFAULT_CONFIG},				//P1-4ADL2DAL-1
+	{0x5461A784, NULL, P1_04ADL2DAL_2_DEFAULT_CONFIG},				//P1-4ADL2DAL-2
+	{0x34605588, &temperatureDriver, P1_04RTD_DEFAULT_CONFIG},		//P1-04RTD
+	{0x34608C81, &temperatureDriver, P1_04THM_DEFAULT_CONFIG},		//P1-04THM
+	{0x34608C8E, &temperatureDriver, P1_04NTC_DEFAULT_CONFIG},		//P1-04NTC
+	{0x1403F481, &pwmDriver, P1_04PWM_DEFAULT_CONFIG},				//P1-04PWM
+	{0x34A5A481, &hscDriver, P1_02HSC_DEFAULT_CONFIG},				//P1-02HSC
+};
+
+static const moduleDriver *findModuleDriver(uint32_t moduleID){
+
+	for(unsigned int i = 0; i < sizeof(moduleDrivers) / sizeof(moduleDrivers[0]); i++){
+		if(moduleDrivers[i].moduleID == moduleID){
+			return &moduleDrivers[i];
+		}
+	}
+	return NULL;
+}
+
+/*******************************************************************************
+Description: Find the driver of a module. Called once per slot at sign-on so the
+			 rest of the library can ask the slot's driver what kind of module
+			 it is instead of checking module IDs or data sizes. Modules in
+			 moduleDrivers use the driver listed there, all others get the
+			 analog or discrete driver from their block sizes.
+
+Parameters: -const moduleProps &props - Module list entry of the module
+
+Returns: 	-const P1_Driver * - Driver of the module. NULL for an empty slot.
+
+Example Code: 
+*******************************************************************************/
+const P1_Driver *resolveDriver(const moduleProps &props){
+	const moduleDriver *entry = findModuleDriver(props.moduleID);
+
+	if((entry != NULL) && (entry->driver != NULL)){
+		return entry->driver;
+	}
+	if((props.aiBytes > 0) || (props.aoBytes > 0)){
+		return &analogDriver;
+	}
+	if((props.diBytes > 0) || (props.doBytes > 0)){
+		return &discreteDriver;
+	}
+	return NULL;
+}
+
+/*******************************************************************************
+Description: Find the configuration sent to a module at sign-on.
+
+Parameters: -const moduleProps &props - Module list entry of the module
+
+Returns: 	-const char * - Default configuration. Modules not in moduleDrivers
+			 get the P1-04ADL-1 configuration.
+
+Example Code: 
+*******************************************************************************/
+const char *moduleDefaultConfig(const moduleProps &props){
+	const moduleDriver *entry = findModuleDriver(props.moduleID);
+
+	if((entry != NULL) && (entry->defaultConfig != NULL)){
+		return entry->defaultConfig;
+	}
+	return P1_04ADL_1_DEFAULT_CONFIG;
+}
@@ -0,0 +1,114 @@
+/*
+MIT License
+
+Copyright (c) 2023 FACTS Engineering, LLC
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef P1_Driver_h
+#define P1_Driver_h
+
+#include "Arduino.h"
+#include "Module_List.h"
+#include "defines.h"
+
+#define SCAN_CHANNELS			9								//Most 32 bit registers used by one module. P1-02HSC
+
+#define DRIVER_NONE			0
+#define DRIVER_DISCRETE		1
+#define DRIVER_ANALOG		2
+#define DRIVER_TEMPERATURE	3
+#define DRIVER_PWM			4
+#define DRIVER_HSC			5
+
+class P1_Driver;
+
+struct slotImage{				//Decoded data of one slot. Filled by the slot's driver once per scan
+	const P1_Driver *driver;
+	moduleProps props;			//Module list entry of the signed on module
+	uint8_t slot;
+	uint16_t diOffset;			//Offsets of this slot's data in each Base Controller block
+	uint16_t doOffset;
+	uint16_t aiOffset;
+	uint16_t aoOffset;
+	uint16_t statusOffset;
+	uint16_t inputs;			//Discrete inputs. Channel 1 is bit 0
+	uint16_t outputs;			//Discrete outputs. Channel 1 is bit 0
+	uint32_t inputValues[SCAN_CHANNELS];	//Analog input registers. Counts or float bits
+	uint32_t outputValues[SCAN_CHANNELS];	//Analog output registers
+	uint8_t quality[SCAN_CHANNELS];			//QUALITY_ flags of each input register
+	bool outputsChanged;
+};
+
+class P1_Driver{				//Decodes and encodes the block data of one module family
+
+	public:
+	virtual uint8_t family(void) const = 0;
+	virtual void decode(slotImage &image, const uint8_t *di, const uint8_t *ai, const uint8_t *status) const = 0;	//Input block bytes to image
+	virtual uint8_t encode(const slotImage &image, uint8_t type, uint8_t *data) const = 0;	//Image to output block bytes. Returns bytes encoded
+};
+
+class P1_DiscreteDriver : public P1_Driver{
+	public:
+	uint8_t family(void) const;
+	void decode(slotImage &image, const uint8_t *di, const uint8_t *ai, const uint8_t *status) const;
+	uint8_t encode(const slotImage &image, uint8_t type, uint8_t *data) const;
+};
+
+class P1_AnalogDriver : public P1_Driver{
+	public:
+	uint8_t family(void) const;
+	void decode(slotImage &image, const uint8_t *di, const uint8_t *ai, const uint8_t *status) const;
+	uint8_t encode(const slotImage &image, uint8_t type, uint8_t *data) const;
+};
+
+class P1_TemperatureDriver : public P1_AnalogDriver{	//Same data as analog. Registers hold floats
+	public:
+	uint8_t family(void) const;
+};
+
+class P1_PWMDriver : public P1_AnalogDriver{			//Output registers are duty, frequency pairs
+	public:
+	uint8_t family(void) const;
+};
+
+class P1_HSCDriver : public P1_Driver{					//Output registers are owned by P1_HSC_Module
+	public:
+	uint8_t family(void) const;
+	void decode(slotImage &image, const uint8_t *di, const uint8_t *ai, const uint8_t *status) const;
+	uint8_t encode(const slotImage &image, uint8_t type, uint8_t *data) const;
+};
+
+extern const P1_DiscreteDriver discreteDriver;
+extern const P1_AnalogDriver analogDriver;
+extern const P1_TemperatureDriver temperatureDriver;
+extern const P1_PWMDriver pwmDriver;
+extern const P1_HSCDriver hscDriver;
+
+struct moduleDriver{			//Module specific knowledge that is not in the module list
+	uint32_t moduleID;
+	const P1_Driver *driver;	//NULL to choose a driver from the block sizes
+	const char *defaultConfig;	//Configuration sent at sign-on. NULL to use the default analog configuration
+};
+
+const P1_Driver *resolveDriver(const moduleProps &props);	//Driver for a module. NULL for an empty slot
+const char *moduleDefaultConfig(const moduleProps &props);	//Configuration sent to a module at sign-on
+
+#endif
@@ -0,0 +1,234 @@
+/*
+MIT License
+
+Copyright (c) 2023 FACTS Engineering, LLC
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include "P1_Filter.h"
+
+/*******************************************************************************
+Description: Constructor for P1_Filter class. Filters analog channels of a
+			 P1_Scan one sample per scan, so noisy inputs no longer need to be
+			 oversampled with extra readAnalog calls. Each filter keeps a fixed
+			 amount of state and does a fixed amount of work per sample.
+
+Parameters: -P1_Scan &scan - Scan holding the analog image
+
+Returns: 	-none
+
+Example Code: 
+*******************************************************************************/
+P1_Filter::P1_Filter(P1_Scan &scan){
+
+	this->scan = &scan;
+	memset(table,0,sizeof(table));
+
+}
+
+/*******************************************************************************
+Description: Filter an analog input channel.
+
+Parameters: -uint8_t slot - Slot of the module. Slots start at 1.
+			-uint8_t channel - Channel of the module. Channels start at 1.
+			-uint8_t type - FILTER_IIR, FILTER_AVERAGE, FILTER_MEDIAN or FILTER_RATE
+			-uint32_t setting - IIR: time constant is 2^setting scans. 1-15
+								Average and median: samples in the window. 1-16
+								Rate: most counts the output may change per scan
+
+Returns: 	-int8_t - Index of the filtered channel. -1 on failure.
+
+Example Code: 
+*******************************************************************************/
+int8_t P1_Filter::addFilter(uint8_t slot, uint8_t channel, uint8_t type, uint32_t setting){
+	slotImage *image = NULL;
+	filterChannel *filter;
+
+	if(count >= FILTER_CHANNELS){
+		debugPrintln("No room for another filter");
+		return -1;
+	}
+	if(!scan->analogChannel(slot,channel).valid()){
+		return -1;
+	}
+
+	image = scan->getSlot(slot);
+	if(channel > (image->props.aiBytes / 4)){
+		debugPrintln("This channel is not valid");
+		return -1;
+	}
+
+	switch(type){
+		case FILTER_IIR:
+			if((setting < 1) || (setting > 15)){
+				setting = 0;
+			}
+			break;
+		case FILTER_AVERAGE:
+		case FILTER_MEDIAN:
+			if(setting > FILTER_WINDOW){
+				setting = 0;
+			}
+			break;
+		case FILTER_RATE:
+			break;
+		default:
+			setting = 0;
+			break;
+	}
+	if(setting == 0){
+		debugPrintln("Filter setting is not valid");
+		return -1;
+	}
+
+	filter = &table[count];
+	filter->image = image;
+	filter->index = channel - 1;
+	filter->type = type;
+	filter->setting = setting;
+	filter->primed = false;
+	return count++;
+}
+
+void P1_Filter::reset(uint8_t index){
+
+	if(index < count){
+		table[index].primed = false;
+	}
+
+}
+
+/*******************************************************************************
+Description: Add the latest scan to every filter. Channels without good data
+			 are skipped and keep their last output.
+
+Parameters: -none
+
+Returns: 	-none
+
+Example Code: 
+*******************************************************************************/
+void P1_Filter::update(void){
+	filterChannel *filter;
+
+	if(!scan->isNewScan(lastSequence)){
+		return;
+	}
+
+	for(int i = 0; i < count; i++){
+		filter = &table[i];
+		if(filter->image->quality[filter->index] & QUALITY_NO_DATA){
+			continue;
+		}
+		if(!filter->primed){
+			prime(*filter,(int32_t)filter->image->inputValues[filter->index]);
+		}
+		else{
+			sample(*filter,(int32_t)filter->image->inputValues[filter->index]);
+		}
+	}
+}
+
+int32_t P1_Filter::read(uint8_t index){
+
+	return (index < count) ? table[index].output : 0;
+
+}
+
+int32_t P1_Filter::readRaw(uint8_t index){
+
+	return (index < count) ? (int32_t)table[index].image->inputValues[table[index].index] : 0;
+
+}
+
+void P1_Filter::prime(filterChannel &filter, int32_t raw){
+
+	filter.output = raw;
+	filter.head = 0;
+	if(filter.type == FILTER_IIR){
+		filter.state = (int64_t)raw * 65536;
+	}
+	else if(filter.type == FILTER_AVERAGE){
+		filter.state = raw * (int32_t)filter.setting;
+	}
+	for(int i = 0; i < FILTER_WINDOW; i++){
+		filter.window[i] = raw;
+		filter.sorted[i] = raw;
+	}
+	filter.primed = true;
+}
+
+void P1_Filter::sample(filterChannel &filter, int32_t raw){
+	int32_t old = 0;
+	int32_t change = 0;
+	uint8_t n = filter.setting;
+	uint8_t i = 0;
+
+	switch(filter.type){
+		case FILTER_IIR:
+			filter.state += (((int64_t)raw * 65536) - filter.state) >> filter.setting;	//Q16 keeps more fractional bits than the largest setting, so a steady input settles exactly
+			filter.output = (int32_t)((filter.state + 32768) >> 16);
+			break;
+
+		case FILTER_AVERAGE:
+			filter.state += raw - filter.window[filter.head];	//Running sum. Add the newest, drop the oldest
+			filter.window[filter.head] = raw;
+			filter.head = (filter.head + 1 < n) ? filter.head + 1 : 0;
+			filter.output = (int32_t)(filter.state / n);
+			break;
+
+		case FILTER_MEDIAN:
+			old = filter.window[filter.head];
+			filter.window[filter.head] = raw;
+			filter.head = (filter.head + 1 < n) ? filter.head + 1 : 0;
+
+			while(filter.sorted[i] != old){		//Replace the oldest sample and slide it into order
+				i++;
+			}
+			while((i < n - 1) && (filter.sorted[i+1] < raw)){
+				filter.sorted[i] = filter.sorted[i+1];
+				i++;
+			}
+			while((i > 0) && (filter.sorted[i-1] > raw)){
+				filter.sorted[i] = filter.sorted[i-1];
+				i--;
+			}
+			filter.sorted[i] = raw;
+
+			if(n & 1){
+				filter.output = filter.sorted[n/2];
+			}
+			else{
+				filter.output = (filter.sorted[n/2 - 1] + filter.sorted[n/2]) / 2;
+			}
+			break;
+
+		case FILTER_RATE:
+			change = raw - filter.output;
+			if(change > (int32_t)filter.setting){
+				change = filter.setting;
+			}
+			else if(change < -(int32_t)filter.setting){
+				change = -(int32_t)filter.setting;
+			}
+			filter.output += change;
+			break;
+	}
+}
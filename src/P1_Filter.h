@@ -0,0 +1,73 @@
+/*
+MIT License
+
+Copyright (c) 2023 FACTS Engineering, LLC
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef P1_Filter_h
+#define P1_Filter_h
+
+#include "P1AM.h"
+#include "P1_Scan.h"
+
+#define FILTER_CHANNELS	8		//Maximum number of filtered channels per filter bank
+#define FILTER_WINDOW	16		//Most samples kept by an average or median filter
+
+#define FILTER_IIR		0		//First order low pass. Setting is the time constant as a power of 2 scans. 1-15
+#define FILTER_AVERAGE	1		//Moving average. Setting is the number of samples. 1-16
+#define FILTER_MEDIAN	2		//Median. Setting is the number of samples. 1-16
+#define FILTER_RATE		3		//Rate of change clamp. Setting is the most counts the output may move per scan
+
+class P1_Filter{
+
+	public:
+	P1_Filter(P1_Scan &scan);
+
+	//Setup - Returns the index of the filtered channel or -1 on failure. Call after scan.begin()
+	int8_t addFilter(uint8_t slot, uint8_t channel, uint8_t type, uint32_t setting);
+	void reset(uint8_t index);		//Start the filter again from the next sample
+
+	//Scan Functions
+	void update(void);				//Add one sample to every filter. Call after scan.update()
+	int32_t read(uint8_t index);	//Filtered value
+	int32_t readRaw(uint8_t index);	//Unfiltered value of the same scan
+
+	private:
+	struct filterChannel{
+		slotImage *image;
+		uint8_t index;				//Register in the slot image
+		uint8_t type;
+		uint32_t setting;
+		bool primed;
+		int32_t output;
+		int64_t state;				//IIR value in Q16 or running sum of the average
+		uint8_t head;				//Oldest sample in the window
+		int32_t window[FILTER_WINDOW];		//Samples in arrival order
+		int32_t sorted[FILTER_WINDOW];		//Same samples in order of value. Median only
+	}table[FILTER_CHANNELS];
+	P1_Scan *scan;
+	uint8_t count = 0;
+	uint32_t lastSequence = 0;
+	void sample(filterChannel &filter, int32_t raw);
+	void prime(filterChannel &filter, int32_t raw);
+};
+
+#endif
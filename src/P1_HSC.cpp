@@ -39,11 +39,15 @@ P1_HSC_Module::P1_HSC_Module(uint8_t slotSelect){
 
 	CNT1.channelNumber = 1;
 	CNT1.slotNumber = slotSelect;
+	CNT1.module = this;
 	
 	CNT2.channelNumber = 2;
 	CNT2.slotNumber = slotSelect;
+	CNT2.module = this;
 	
 	slotNumber = slotSelect;
+	memset(&snapshot,0,sizeof(snapshot));
+	memset(shadowRegisters,0,sizeof(shadowRegisters));
 }
 
 /*******************************************************************************	
@@ -73,10 +77,12 @@ void P1_HSC_Module::configureChannels(void){
 	cfgBuf[11] += CNT2.enableZReset << 6;	//Bit 6
 	cfgBuf[11] += CNT2.isRotary << 7;		//Bit 7
 
+	holdRegisters();		//Send rollovers and presets as one block write
 	CNT1.setRolloverPosition(CNT1.rolloverPosition);
 	CNT2.setRolloverPosition(CNT2.rolloverPosition);
 	CNT1.setPosition(0);
 	CNT2.setPosition(0);
+	commitRegisters();
 	
 	P1.configureModule(cfgBuf,slotNumber);
 	delay(100);
@@ -111,10 +117,14 @@ void P1_HSC_Module::configureChannels(P1_HSC_Channel CH1, P1_HSC_Channel CH2){
 	cfgBuf[11] += CH2.enableZReset << 6;	//Bit 6
 	cfgBuf[11] += CH2.isRotary << 7;		//Bit 7
 
+	CH1.module = this;		//Send rollovers and presets as one block write
+	CH2.module = this;
+	holdRegisters();
 	CH1.setRolloverPosition(CH1.rolloverPosition);
 	CH2.setRolloverPosition(CH2.rolloverPosition);
 	CH1.setPosition(0);
 	CH2.setPosition(0);
+	commitRegisters();
 
 	P1.configureModule(cfgBuf,slotNumber);
 	delay(100);
@@ -136,6 +146,58 @@ uint8_t P1_HSC_Module::readInputs(void){
 	uint8_t reading = 0;
 	
 	reading = P1.readDiscrete(slotNumber);
+	updateInputStatus(reading);
+	
+	return reading;
+}
+
+/*******************************************************************************	
+Description: Reads both channel positions, both alert status registers and the 8
+			 inputs of the P1-02HSC in a single snapshot of the module's data.
+			 All values come from the same Base Controller scan and share one
+			 timestamp. Additionally updates the bool parameters for each input
+			 and the snapshot property of the P1_HSC_Module object.
+			 
+Parameters: -none
+			 
+Returns: 	- hscSnapshot - positions, alerts, inputs, timestamp and scan sequence
+
+Example Code: 
+*******************************************************************************/
+hscSnapshot P1_HSC_Module::readSnapshot(void){
+	uint8_t analogData[20];		//Registers 1-5. Positions and alerts
+	uint8_t discreteData[2];
+	blockRegion regions[2];
+	int32_t reg[5];
+
+	regions[0] = {(char *)analogData, sizeof(analogData), P1.blockOffset(slotNumber,ANALOG_IN_BLOCK), ANALOG_IN_BLOCK};
+	regions[1] = {(char *)discreteData, sizeof(discreteData), P1.blockOffset(slotNumber,DISCRETE_IN_BLOCK), DISCRETE_IN_BLOCK};
+
+	snapshot.scanSequence = P1.readBlockSnapshot(regions,2);
+	if(snapshot.scanSequence == 0){
+		return snapshot;		//Keep the last good values
+	}
+	snapshot.timestamp = P1.getScanTimestamp();
+
+	decodeAnalogBlock(analogData,reg,5);
+
+	snapshot.position1 = reg[0];
+	snapshot.position2 = reg[1];
+	snapshot.alerts1 = reg[3];
+	snapshot.alerts2 = reg[4];
+	snapshot.inputs = discreteData[0];
+	updateInputStatus(snapshot.inputs);
+
+	CNT1.trackRollOver(snapshot.alerts1);
+	CNT1.trackPosition(snapshot.position1,snapshot.timestamp,snapshot.scanSequence);
+	CNT2.trackRollOver(snapshot.alerts2);
+	CNT2.trackPosition(snapshot.position2,snapshot.timestamp,snapshot.scanSequence);
+
+	return snapshot;
+}
+
+void P1_HSC_Module::updateInputStatus(uint8_t reading){
+
 	inputStatus = reading & 0xFF;
 	
 	status1A  = (reading & 0x01);
@@ -146,8 +208,113 @@ uint8_t P1_HSC_Module::readInputs(void){
 	status2B  = (reading & 0x20) >> 5;
 	status2Z  = (reading & 0x40) >> 6;
 	status4IN = (reading & 0x80) >> 7;
+
+}
+
+/*******************************************************************************	
+Description: Hold channel register writes in the module's register shadow instead
+			 of sending them. Use with commitRegisters to send several setPosition,
+			 setZResetValue and setRolloverPosition calls as one block write.
+			 
+Parameters: -none
+			 
+Returns: 	-none
+
+Example Code: 
+*******************************************************************************/
+void P1_HSC_Module::holdRegisters(void){
+	
+	holding = true;
+	
+}
+
+/*******************************************************************************	
+Description: Send every staged register write to the module in one block write
+			 of its analog output region. Position presets raise their load bit
+			 in the same write as the preset value. That write is always synced
+			 to a Base Controller scan so the module sees the bit, then a second
+			 write lowers it again, so each commit sends a full load pulse and
+			 never leaves a load bit high.
+			 
+Parameters: -none
+			 
+Returns: 	-none
+
+Example Code: 
+*******************************************************************************/
+void P1_HSC_Module::commitRegisters(void){
+	uint8_t tData[HSC_REGISTERS * 4];
+	int32_t registers[HSC_REGISTERS];
+	uint16_t offset = 0;
+	uint8_t policy = 0;
+	int first = 0;
+	int last = 0;
+	
+	holding = false;
+	if(!shadowLoaded){
+		loadShadow();
+	}
+	if(pendingLoad){
+		dirtyRegisters |= 1;		//Control register carries the load bits
+	}
+	if(dirtyRegisters == 0){
+		return;
+	}
+	offset = P1.blockOffset(slotNumber,ANALOG_OUT_BLOCK);
+	
+	while(!(dirtyRegisters & (1 << first))){
+		first++;
+	}
+	last = HSC_REGISTERS - 1;
+	while(!(dirtyRegisters & (1 << last))){
+		last--;
+	}
+	
+	memcpy(registers,shadowRegisters,sizeof(registers));
+	registers[0] |= pendingLoad;
+	encodeAnalogBlock(registers + first,tData,last - first + 1);
+	
+	if(pendingLoad){
+		policy = P1.getSyncPolicy();
+		P1.setSyncPolicy(SYNC_STRICT);		//Module has to see the load bit before it is lowered
+		P1.writeBlockData((char *)tData,(last - first + 1) * 4,offset + (first * 4),ANALOG_OUT_BLOCK);
+		P1.setSyncPolicy(policy);
+		
+		encodeAnalogBlock((const int32_t *)shadowRegisters,tData,1);	//Falling edge of the load pulse
+		P1.writeBlockData((char *)tData,4,offset,ANALOG_OUT_BLOCK);
+	}
+	else{
+		P1.writeBlockData((char *)tData,(last - first + 1) * 4,offset + (first * 4),ANALOG_OUT_BLOCK);
+	}
+	
+	pendingLoad = 0;
+	dirtyRegisters = 0;
+}
+
+void P1_HSC_Module::stageRegister(uint8_t reg, uint32_t value){
+	
+	if(!shadowLoaded){
+		loadShadow();
+	}
+	shadowRegisters[reg-1] = value;
+	dirtyRegisters |= 1 << (reg-1);
+	
+}
+
+void P1_HSC_Module::stageLoad(uint32_t loadBits){
+	
+	pendingLoad |= loadBits;
+	
+}
+
+void P1_HSC_Module::loadShadow(void){
+	uint8_t rData[HSC_REGISTERS * 4];
+	
+	P1.readBlockData((char *)rData,sizeof(rData),P1.blockOffset(slotNumber,ANALOG_OUT_BLOCK),ANALOG_OUT_BLOCK);
+	decodeAnalogBlock(rData,(int32_t *)shadowRegisters,HSC_REGISTERS);
+	shadowRegisters[0] &= ~(uint32_t)0x10001;	//Load bits are tracked separately
+	shadowLoaded = true;
 	
-	return reading;
 }
 
 /*******************************************************************************	
@@ -167,12 +334,17 @@ P1_HSC_Channel::P1_HSC_Channel(uint8_t slotSelect, uint8_t channelSelect){
 
 	slotNumber = slotSelect;
 	channelNumber = channelSelect;
+	resetVelocity();
 
 }
 
 /*******************************************************************************	
 Description: Reads the current positon of the channel in counts. Value is a 
-			 32 bit unsigned interger and will roll under/over at 0xFFFFFFFF
+			 32 bit unsigned interger and will roll under/over at 0xFFFFFFFF.
+			 The read does not wait for a Base Controller scan, so the sample
+			 for velocity is stamped with micros() when the read returns. Use
+			 P1_HSC_Module::readSnapshot for samples stamped with the end of
+			 the scan they came from.
 			 
 Parameters: -none
 			 
@@ -181,8 +353,34 @@ Returns: 	-int current position in counts
 Example Code: 
 *******************************************************************************/
 int P1_HSC_Channel::readPosition(void){
+	int position = 0;
 	
-	return (int)P1.readAnalog(slotNumber,channelNumber);
+	position = (int)P1.readAnalog(slotNumber,channelNumber);
+	trackPosition(position,micros(),0);
+	
+	return position;
+}
+
+/*******************************************************************************	
+Description: Reads the current position of the channel and returns the 64 bit
+			 extended position. The extended position keeps counting past the
+			 32 bit limit and, for rotary encoders, past the rollover position,
+			 so long running axes never lose revolutions. It is updated by every
+			 readPosition and P1_HSC_Module::readSnapshot call, and stays correct
+			 as long as the channel moves less than half of a revolution (or 2^31
+			 counts) between samples. readAlerts and readRollOver only update the
+			 roll-over and roll-under counters.
+			 
+Parameters: -none
+			 
+Returns: 	-int64_t extended position in counts
+
+Example Code: 
+*******************************************************************************/
+int64_t P1_HSC_Channel::readExtendedPosition(void){
+	
+	readPosition();
+	return extendedPosition;
 	
 }
 
@@ -208,9 +406,67 @@ void P1_HSC_Channel::setPosition(int counts){
 		bitPosition = 0x10000;
 	}
 	
-	P1.writeAnalog(counts,slotNumber,registerOffset);	//Set position
-	P1.writeAnalog(bitPosition,slotNumber,1);//Trigger set position load bit
-	P1.writeAnalog(0,slotNumber,1);	//Reset flag bit
+	if(module != NULL){
+		module->stageRegister(registerOffset,counts);	//Set position
+		module->stageLoad(bitPosition);					//Trigger set position load bit in the same write
+		if(!module->holding){
+			module->commitRegisters();
+		}
+	}
+	else{
+		P1.writeAnalog(counts,slotNumber,registerOffset);	//Set position
+		P1.writeAnalog(bitPosition,slotNumber,1);//Trigger set position load bit
+		P1.writeAnalog(0,slotNumber,1);	//Reset flag bit
+	}
+
+	extendedPosition = counts;	//Restart extended position from the new value
+	lastPosition = counts;
+	positionTracked = true;
+	resetVelocity();			//Don't estimate across the jump in position
+}
+
+/*******************************************************************************	
+Description: Reads the current position of the channel and returns the velocity.
+			 The velocity and acceleration properties are also updated every time
+			 the position is sampled by readPosition or P1_HSC_Module::readSnapshot.
+			 The estimate uses the measured time between samples rather than the
+			 loop period, and the extended position, so the 32 bit wrap and the
+			 rotary rollover do not cause spikes.
+			 
+Parameters: -none
+			 
+Returns: 	-float velocity in counts per second
+
+Example Code: 
+*******************************************************************************/
+float P1_HSC_Channel::readVelocity(void){
+	
+	readPosition();
+	return velocity;
+	
+}
+
+/*******************************************************************************	
+Description: Sets how many position samples are used to estimate velocity and
+			 acceleration. A longer window filters more noise but responds more
+			 slowly to changes in speed. 
+			 
+Parameters: -uint8_t samples - Window length. 2 to HSC_VELOCITY_SAMPLES. Default is 4.
+			 
+Returns: 	-none
+
+Example Code: 
+*******************************************************************************/
+void P1_HSC_Channel::setVelocityWindow(uint8_t samples){
+	
+	if(samples < 2){
+		samples = 2;
+	}
+	else if(samples > HSC_VELOCITY_SAMPLES){
+		samples = HSC_VELOCITY_SAMPLES;
+	}
+	velocityWindow = samples;
+	
 }
 
 /*******************************************************************************	
@@ -234,7 +490,7 @@ void P1_HSC_Channel::setZResetValue(int counts){
 		registerOffset = 6;
 	}
 	
-	P1.writeAnalog(counts,slotNumber,registerOffset);	//Set Z reset position
+	writeRegister(registerOffset,counts);	//Set Z reset position
 	
 }
 
@@ -260,15 +516,16 @@ void P1_HSC_Channel::setRolloverPosition(int counts){
 	
 	
 	rolloverPosition = counts;	//Store current rollover in case init is called again
-	P1.writeAnalog(counts,slotNumber,registerOffset);	
+	writeRegister(registerOffset,counts);	
 	
 }
 
 /*******************************************************************************	
 Description: Function to use when polling for a rollover event. This flag will
-			 only trigger when using the rotary encoder setting. The rollover
-			 will not be counted by this function and it must be polled continuously
-			 polled to see each individual event
+			 only trigger when using the rotary encoder setting. Each event is
+			 returned once, on the first poll that sees the flag set. This function
+			 does not wait for the flag to clear. Events are also counted in
+			 rollOverCount and rollUnderCount.
 							
 Parameters: -none
 			 
@@ -280,7 +537,6 @@ Example Code:
 *******************************************************************************/
 int P1_HSC_Channel::readRollOver(void){
 	uint8_t registerOffset = 0;
-	int statusValue = 0;
 	
 	if(channelNumber == 1){
 		registerOffset = 4;
@@ -289,22 +545,166 @@ int P1_HSC_Channel::readRollOver(void){
 		registerOffset = 5;
 	}
 	
-	statusValue = P1.readAnalog(slotNumber,registerOffset);	
-	statusValue = (statusValue & 0x3000000) >> 24;
+	return trackRollOver(P1.readAnalog(slotNumber,registerOffset));
+}
+
+/*******************************************************************************	
+Description: Write a channel register. Goes through the module's register shadow
+			 when the channel belongs to a P1_HSC_Module, otherwise writes the
+			 register directly.
+							
+Parameters: -uint8_t reg - Analog output register. Registers start at 1.
+			-uint32_t value - Value to write
+			 
+Returns: 	-none
+*******************************************************************************/
+void P1_HSC_Channel::writeRegister(uint8_t reg, uint32_t value){
+	
+	if(module != NULL){
+		module->stageRegister(reg,value);
+		if(!module->holding){
+			module->commitRegisters();
+		}
+	}
+	else{
+		P1.writeAnalog(value,slotNumber,reg);
+	}
+}
 
-	if(statusValue == 0b10){
-		while(statusValue == 0b10){
-			statusValue = P1.readAnalog(slotNumber,registerOffset);	
-			statusValue = (statusValue & 0x3000000) >> 24;
+/*******************************************************************************	
+Description: Update the extended position from a new position sample. The change
+			 since the last sample is taken as a signed 32 bit difference, so the
+			 32 bit wrap is handled. For rotary channels a change of more than half
+			 of the rollover position is treated as a roll-over or roll-under.
+							
+Parameters: -int position - Position read from the module
+			-uint32_t timestamp - micros() when the position was sampled
+			-uint32_t sequence - Scan sequence number it came from. 0 if the
+			 read was not aligned to a scan
+			 
+Returns: 	-none
+*******************************************************************************/
+void P1_HSC_Channel::trackPosition(int position, uint32_t timestamp, uint32_t sequence){
+	int32_t delta = 0;
+	int32_t span = rolloverPosition;
+	
+	if(!positionTracked){
+		extendedPosition = position;
+		lastPosition = position;
+		positionTracked = true;
+		trackVelocity(timestamp,sequence);
+		return;
+	}
+	
+	delta = (int32_t)((uint32_t)position - (uint32_t)lastPosition);
+	if(isRotary && (span > 0)){
+		if(delta > (span / 2)){
+			delta -= span;		//Rolled under
+		}
+		else if(delta < -(span / 2)){
+			delta += span;		//Rolled over
 		}
+	}
+	
+	extendedPosition += delta;
+	lastPosition = position;
+	trackVelocity(timestamp,sequence);
+}
+
+/*******************************************************************************	
+Description: Store the newest extended position sample and update velocity and
+			 acceleration. Velocity is the change in position across the window
+			 divided by the measured time across it. Acceleration is the change
+			 between the velocities of the older and newer half of the window.
+							
+Parameters: -uint32_t timestamp - micros() when the position was sampled
+			-uint32_t sequence - Scan sequence number the position came from.
+			 0 if the read was not aligned to a scan
+			 
+Returns: 	-none
+*******************************************************************************/
+void P1_HSC_Channel::trackVelocity(uint32_t timestamp, uint32_t sequence){
+	uint8_t newest = 0;
+	uint8_t middle = 0;
+	uint8_t oldest = 0;
+	uint8_t window = 0;
+	uint32_t dtOld = 0;
+	uint32_t dtNew = 0;
+	float velocityOld = 0;
+	float velocityNew = 0;
+	
+	if((sampleCount > 0) && (((sequence != 0) && (sequence == lastSequence)) || (timestamp == sampleTime[sampleHead]))){
+		samplePosition[sampleHead] = extendedPosition;	//Same scan sampled twice, or no time between samples
+		return;
+	}
+	lastSequence = sequence;
+	
+	sampleHead = (sampleHead + 1) % HSC_VELOCITY_SAMPLES;
+	samplePosition[sampleHead] = extendedPosition;
+	sampleTime[sampleHead] = timestamp;
+	if(sampleCount < HSC_VELOCITY_SAMPLES){
+		sampleCount++;
+	}
+	
+	window = (sampleCount < velocityWindow) ? sampleCount : velocityWindow;
+	if(window < 2){
+		return;
+	}
+	
+	newest = sampleHead;
+	oldest = (sampleHead + HSC_VELOCITY_SAMPLES - (window - 1)) % HSC_VELOCITY_SAMPLES;
+	middle = (sampleHead + HSC_VELOCITY_SAMPLES - ((window - 1) / 2)) % HSC_VELOCITY_SAMPLES;
+	
+	velocity = (float)(samplePosition[newest] - samplePosition[oldest]) * 1000000.0f / (float)(sampleTime[newest] - sampleTime[oldest]);
+	
+	if((window < 3) || (middle == oldest) || (middle == newest)){
+		return;		//Need a point between the ends for acceleration
+	}
+	
+	dtOld = sampleTime[middle] - sampleTime[oldest];
+	dtNew = sampleTime[newest] - sampleTime[middle];
+	velocityOld = (float)(samplePosition[middle] - samplePosition[oldest]) * 1000000.0f / (float)dtOld;
+	velocityNew = (float)(samplePosition[newest] - samplePosition[middle]) * 1000000.0f / (float)dtNew;
+	acceleration = (velocityNew - velocityOld) * 2000000.0f / (float)(dtOld + dtNew);	//Half windows are centred (dtOld + dtNew) / 2 apart
+}
+
+void P1_HSC_Channel::resetVelocity(void){
+	
+	sampleHead = 0;
+	sampleCount = 0;
+	velocity = 0;
+	acceleration = 0;
+	
+}
+
+/*******************************************************************************	
+Description: Edge detect the roll-over and roll-under bits of the alert status
+			 register. An event is counted when its bit is first seen set.
+							
+Parameters: -uint32_t alerts - Alert status register of the channel
+			 
+Returns: 	-int rollover event. Returns 1 for roll-over, -1 for roll-under, 0 for
+			 no new event. If both are new, both are counted and -1 is returned.
+*******************************************************************************/
+int P1_HSC_Channel::trackRollOver(uint32_t alerts){
+	uint8_t statusValue = 0;
+	uint8_t newEvents = 0;
+	
+	statusValue = (alerts & 0x3000000) >> 24;
+	newEvents = statusValue & ~lastRollStatus;	//Only bits that were not set last time
+	lastRollStatus = statusValue;
+	
+	if(newEvents & 0b01){
+		rollOverCount++;
+	}
+	if(newEvents & 0b10){
+		rollUnderCount++;
+	}
+	
+	if(newEvents & 0b10){
 		return -1; 	//Rolled under
 	}
-	else if(statusValue == 0b01){
-		
-		while(statusValue == 0b01){
-			statusValue = P1.readAnalog(slotNumber,registerOffset);	
-			statusValue = (statusValue & 0x3000000) >> 24;
-		}
+	else if(newEvents & 0b01){
 		return 1;	//Rolled Over
 	}
 	else{
@@ -353,6 +753,7 @@ Example Code:
 *******************************************************************************/
 uint32_t P1_HSC_Channel::readAlerts(void){
 	uint8_t registerOffset = 0;
+	uint32_t alerts = 0;
 	
 	if(channelNumber == 1){
 		registerOffset = 4;
@@ -361,6 +762,145 @@ uint32_t P1_HSC_Channel::readAlerts(void){
 		registerOffset = 5;
 	}
 	
-	return P1.readAnalog(slotNumber,registerOffset);
+	alerts = P1.readAnalog(slotNumber,registerOffset);
+	trackRollOver(alerts);
 	
-}
\ No newline at end of file
+	return alerts;
+}
+
+/*******************************************************************************	
+Description: Constructor for P1_HSC_Capture class. Captures the position of a
+			 P1-02HSC channel whenever one of its inputs changes, e.g. for
+			 registration marks on the Z or IN input. Inputs and positions are
+			 read in the same snapshot so the two always line up. Records are
+			 kept in a single producer, single consumer queue, so they can be
+			 drained with read from a different context than poll runs in
+			 without disabling interrupts.
+			 Input pulses shorter than a Base Controller scan can not be seen.
+			 
+Parameters: -P1_HSC_Module &hscModule - Module to capture from
+			 
+Returns: 	-none
+
+Example Code: 
+*******************************************************************************/
+P1_HSC_Capture::P1_HSC_Capture(P1_HSC_Module &hscModule){
+
+	module = &hscModule;
+
+}
+
+/*******************************************************************************	
+Description: Select which input edges queue a record. Masks use the bit order of
+			 P1_HSC_Module::readInputs: bits 0-3 are 1A, 1B, 1Z, 3IN and bits 4-7
+			 are 2A, 2B, 2Z, 4IN. Default is the rising edge of both Z inputs.
+			 
+Parameters: -uint8_t rising - Inputs to capture on a rising edge
+			-uint8_t falling - Inputs to capture on a falling edge
+			 
+Returns: 	-none
+
+Example Code: 
+*******************************************************************************/
+void P1_HSC_Capture::setEdges(uint8_t rising, uint8_t falling){
+
+	risingMask = rising;
+	fallingMask = falling;
+
+}
+
+/*******************************************************************************	
+Description: Read the module's inputs and positions in one snapshot and queue a
+			 record for each channel with a selected edge. The first poll only
+			 records the starting state of the inputs.
+			 
+Parameters: -none
+			 
+Returns: 	-uint8_t - Number of records queued
+
+Example Code: 
+*******************************************************************************/
+uint8_t P1_HSC_Capture::poll(void){
+	hscSnapshot sample;
+	uint8_t changed = 0;
+	uint8_t edges = 0;
+	uint8_t queued = 0;
+
+	sample = module->readSnapshot();
+	if(sample.scanSequence == 0){
+		return 0;
+	}
+	if(!started){
+		lastInputs = sample.inputs;
+		started = true;
+		return 0;
+	}
+
+	changed = sample.inputs ^ lastInputs;
+	edges = (changed & sample.inputs & risingMask) | (changed & ~sample.inputs & fallingMask);
+	lastInputs = sample.inputs;
+
+	if(edges & 0x0F){
+		push(sample,1,sample.inputs & 0x0F,edges & 0x0F);
+		queued++;
+	}
+	if(edges & 0xF0){
+		push(sample,2,sample.inputs >> 4,edges >> 4);
+		queued++;
+	}
+	return queued;
+}
+
+/*******************************************************************************	
+Description: Number of records waiting to be read.
+			 
+Parameters: -none
+			 
+Returns: 	-uint8_t - Records in the queue
+
+Example Code: 
+*******************************************************************************/
+uint8_t P1_HSC_Capture::available(void){
+
+	return (uint8_t)(head - tail) & (HSC_CAPTURE_SIZE - 1);
+
+}
+
+/*******************************************************************************	
+Description: Remove the oldest record from the queue.
+			 
+Parameters: -hscCapture &record - Receives the record
+			 
+Returns: 	-bool - false if the queue was empty
+
+Example Code: 
+*******************************************************************************/
+bool P1_HSC_Capture::read(hscCapture &record){
+	uint8_t index = tail;
+
+	if(index == head){
+		return false;
+	}
+	record = ring[index];
+	__sync_synchronize();		//Finish copying the record before handing the slot back
+	tail = (index + 1) & (HSC_CAPTURE_SIZE - 1);
+	return true;
+}
+
+void P1_HSC_Capture::push(const hscSnapshot &sample, uint8_t channel, uint8_t inputs, uint8_t edges){
+	uint8_t index = head;
+	uint8_t next = (index + 1) & (HSC_CAPTURE_SIZE - 1);
+
+	if(next == tail){
+		overflows++;		//Full. Keep the older records
+		return;
+	}
+	ring[index].timestamp = sample.timestamp;
+	ring[index].scanSequence = sample.scanSequence;
+	ring[index].position = (channel == 1) ? module->CNT1.extendedPosition : module->CNT2.extendedPosition;
+	ring[index].channel = channel;
+	ring[index].inputs = inputs;
+	ring[index].edges = edges;
+	__sync_synchronize();		//Record must be complete before it is published
+	head = next;
+}
@@ -36,9 +36,36 @@ SOFTWARE.
 #define quad4x  1
 #define quad1x  2
 
+#define HSC_VELOCITY_SAMPLES 8	//Largest velocity window. Each sample uses 12 bytes per channel
+
+#define HSC_REGISTERS 9			//Analog output registers of the P1-02HSC. 4 bytes each
+
+#define HSC_CAPTURE_SIZE 16		//Records held by P1_HSC_Capture. Must be a power of 2
+
 #define negativeDirection 0
 #define positiveDirection 1
 
+struct hscSnapshot{			//Both counters of a P1-02HSC read from the same Base Controller scan
+	int position1;				//CNT1 position in counts
+	int position2;				//CNT2 position in counts
+	uint32_t alerts1;			//CNT1 alert status register
+	uint32_t alerts2;			//CNT2 alert status register
+	uint8_t inputs;				//Bitmapped state of the 8 inputs. Same as P1_HSC_Module::readInputs
+	uint32_t timestamp;			//micros() when the snapshot was taken
+	uint32_t scanSequence;		//Base Controller scan the snapshot came from. 0 if the read failed
+};
+
+struct hscCapture{				//Position of a channel captured when one of its inputs changed
+	uint32_t timestamp;			//micros() when the inputs and position were sampled
+	uint32_t scanSequence;		//Base Controller scan the sample came from
+	int64_t position;			//Extended position of the channel
+	uint8_t channel;			//Channel 1 or 2
+	uint8_t inputs;				//State of the channel's A, B, Z and IN inputs. Bit 0 is A
+	uint8_t edges;				//Inputs that changed. Same bit order as inputs
+};
+
+class P1_HSC_Module;
+
 class P1_HSC_Channel{
 
 	public:
@@ -69,6 +96,37 @@ class P1_HSC_Channel{
 	//Default rollover
 	int rolloverPosition = 0x7FFFFFFF;	//Default to max
 
+	//Extended position - Updated every time the position or alerts are sampled
+	int64_t readExtendedPosition(void);	//Samples position and returns the 64 bit extended position
+	int64_t extendedPosition = 0;		//Position that does not wrap at 32 bits or at the rotary rollover position
+	uint32_t rollOverCount = 0;			//Number of roll-over events seen in the alert status bits
+	uint32_t rollUnderCount = 0;		//Number of roll-under events seen in the alert status bits
+
+	//Velocity and acceleration - Estimated from the timestamped extended position samples
+	float readVelocity(void);				//Samples position and returns velocity in counts/s
+	void setVelocityWindow(uint8_t samples);//Number of samples (2 to HSC_VELOCITY_SAMPLES) used for the estimate
+	float velocity = 0;						//counts/s. Updated every time the position is sampled
+	float acceleration = 0;					//counts/s^2. Updated every time the position is sampled
+
+	private:
+	friend class P1_HSC_Module;
+	friend class P1_HSC_Compare;
+	P1_HSC_Module *module = NULL;	//Module that holds the register shadow. NULL for stand alone channels
+	void writeRegister(uint8_t reg, uint32_t value);
+	void trackPosition(int position, uint32_t timestamp, uint32_t sequence);
+	int trackRollOver(uint32_t alerts);
+	void trackVelocity(uint32_t timestamp, uint32_t sequence);
+	void resetVelocity(void);
+	int lastPosition = 0;
+	bool positionTracked = false;
+	uint8_t lastRollStatus = 0;
+	int64_t samplePosition[HSC_VELOCITY_SAMPLES];
+	uint32_t sampleTime[HSC_VELOCITY_SAMPLES];
+	uint32_t lastSequence = 0;		//Scan of the newest sample
+	uint8_t sampleHead = 0;
+	uint8_t sampleCount = 0;
+	uint8_t velocityWindow = 4;
+
 };
 
 class P1_HSC_Module{
@@ -91,12 +149,56 @@ class P1_HSC_Module{
 
 	//User Functions
 	uint8_t readInputs(void);		//Return bitmapped output and updates the status bool properties
+	hscSnapshot readSnapshot(void);	//Read both positions, alerts and inputs in one transaction. Also updates the status bool properties
+	hscSnapshot snapshot;			//Result of the last readSnapshot
 	void configureChannels(void);	//intialises module with configuration of CNT1 and CNT2
 	void configureChannels(P1_HSC_Channel CH1, P1_HSC_Channel CH2);	//Init option for custom channel class instances
 
+	//Register Functions - Channel register writes go through a shadow of the module's analog outputs
+	void holdRegisters(void);		//Stage channel register writes instead of sending them
+	void commitRegisters(void);		//Send all staged register writes in one block write
+
 	private:
+	friend class P1_HSC_Channel;
 	uint8_t slotNumber = 0;
 	bool checkIfHSC(uint8_t slot);
+	void updateInputStatus(uint8_t reading);
+	void stageRegister(uint8_t reg, uint32_t value);
+	void stageLoad(uint32_t loadBits);
+	void loadShadow(void);
+	uint32_t shadowRegisters[HSC_REGISTERS];
+	uint16_t dirtyRegisters = 0;	//Bit 0 is register 1
+	uint32_t pendingLoad = 0;		//Load bits to raise on the next commit
+	bool shadowLoaded = false;
+	bool holding = false;
+};
+
+class P1_HSC_Capture{
+
+	public:
+	P1_HSC_Capture(P1_HSC_Module &hscModule);
+
+	//Setup
+	void setEdges(uint8_t rising, uint8_t falling);	//Inputs to capture on. Bitmapped like P1_HSC_Module::readInputs
+
+	//Producer
+	uint8_t poll(void);				//Sample inputs and positions together and queue a record per channel that changed
+
+	//Consumer
+	uint8_t available(void);		//Number of records waiting
+	bool read(hscCapture &record);	//Remove the oldest record. Returns false if there are none
+	uint32_t overflows = 0;			//Records dropped because the queue was full
+
+	private:
+	P1_HSC_Module *module;
+	hscCapture ring[HSC_CAPTURE_SIZE];
+	volatile uint8_t head = 0;		//Only written by poll
+	volatile uint8_t tail = 0;		//Only written by read
+	uint8_t risingMask = 0x44;		//Z inputs by default
+	uint8_t fallingMask = 0;
+	uint8_t lastInputs = 0;
+	bool started = false;
+	void push(const hscSnapshot &sample, uint8_t channel, uint8_t inputs, uint8_t edges);
 };
 
 #endif
@@ -0,0 +1,217 @@
+/*
+MIT License
+
+Copyright (c) 2023 FACTS Engineering, LLC
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include "P1_HSC_Compare.h"
+
+/*******************************************************************************	
+Description: Constructor for P1_HSC_Compare class. The compare engine watches one
+			 or more P1-02HSC channels and switches discrete outputs when their
+			 extended position crosses a table of setpoints. Outputs are written
+			 through a P1_Image, so every output change in a run is sent with one
+			 block write.
+			 
+Parameters: -P1_Image &outputImage - Image used to write the discrete outputs.
+			 begin() must be called on it before run().
+			 
+Returns: 	-none
+
+Example Code: 
+*******************************************************************************/
+P1_HSC_Compare::P1_HSC_Compare(P1_Image &outputImage){
+
+	image = &outputImage;
+
+}
+
+/*******************************************************************************	
+Description: Add a setpoint to the table. The table is kept sorted by position so
+			 setpoints crossed in the same run are applied in the order the
+			 position passed them.
+			 
+Parameters: -P1_HSC_Channel &channel - Channel to watch
+			-int64_t position - Setpoint in extended position counts
+			-uint16_t outputPoint - Discrete output point in the P1_Image
+			-bool stateAbove - State of the output at or above the setpoint. The
+			 output takes the opposite state once the position falls more than
+			 hysteresis counts below the setpoint.
+			 
+Returns: 	-bool - false if the table is full
+
+Example Code: 
+*******************************************************************************/
+bool P1_HSC_Compare::addSetpoint(P1_HSC_Channel &channel, int64_t position, uint16_t outputPoint, bool stateAbove){
+	int i = 0;
+
+	if(count >= HSC_COMPARE_POINTS){
+		debugPrintln("Compare table is full");
+		return false;
+	}
+
+	i = count;
+	while((i > 0) && (table[i-1].position > position)){
+		table[i] = table[i-1];		//Insertion sort by position
+		i--;
+	}
+	table[i].channel = &channel;
+	table[i].position = position;
+	table[i].point = outputPoint;
+	table[i].stateAbove = stateAbove;
+	table[i].above = false;
+	table[i].started = false;
+	count++;
+
+	return true;
+}
+
+void P1_HSC_Compare::clearSetpoints(void){
+
+	count = 0;
+
+}
+
+/*******************************************************************************	
+Description: Sample every watched channel, switch the outputs of any setpoint that
+			 was crossed since the last run and flush the outputs. Each P1-02HSC
+			 is read with one snapshot and all outputs are written with one block
+			 write, so a run costs one transaction per module plus one. On the
+			 first run outputs are set to match the current position. Call this
+			 as often as possible from loop().
+			 
+Parameters: -none
+			 
+Returns: 	-uint8_t - Number of setpoints that fired this run
+
+Example Code: 
+*******************************************************************************/
+uint8_t P1_HSC_Compare::run(void){
+	uint32_t sampleTime = 0;
+	uint8_t fired = 0;
+	int64_t position = 0;
+	bool changed = false;
+
+	if(count == 0){
+		return 0;
+	}
+	sampleTime = sampleChannels();
+
+	//New setpoints set their output to match the current position. When several setpoints share an
+	//output, the highest one below the position wins, or the lowest one if the position is below all of them.
+	for(int i = count - 1; i >= 0; i--){
+		position = table[i].channel->extendedPosition;
+		if(!table[i].started && (position < table[i].position)){
+			table[i].above = false;
+			image->writeOutput(table[i].point, !table[i].stateAbove);
+			table[i].started = true;
+			changed = true;
+		}
+	}
+	for(int i = 0; i < count; i++){
+		if(!table[i].started){
+			table[i].above = true;
+			image->writeOutput(table[i].point, table[i].stateAbove);
+			table[i].started = true;
+			changed = true;
+		}
+	}
+
+	for(int i = 0; i < count; i++){		//Rising crossings in ascending order
+		position = table[i].channel->extendedPosition;
+		if(!table[i].above && (position >= table[i].position)){
+			table[i].above = true;
+			image->writeOutput(table[i].point, table[i].stateAbove);
+			fired++;
+		}
+	}
+
+	for(int i = count - 1; i >= 0; i--){	//Falling crossings in descending order
+		position = table[i].channel->extendedPosition;
+		if(table[i].above && (position < (table[i].position - (int64_t)hysteresis))){
+			table[i].above = false;
+			image->writeOutput(table[i].point, !table[i].stateAbove);
+			fired++;
+		}
+	}
+
+	if(fired || changed){
+		image->flush();
+	}
+	if(fired){
+		lastLatency = micros() - sampleTime;
+		if(lastLatency > maxLatency){
+			maxLatency = lastLatency;
+		}
+		triggerCount += fired;
+	}
+
+	return fired;
+}
+
+/*******************************************************************************	
+Description: Update the extended position of every watched channel. Channels that
+			 belong to the same P1_HSC_Module share one snapshot. A snapshot is
+			 stamped with the end of the scan it came from, so the wait for
+			 that scan is not counted as latency. A channel without a module
+			 is stamped when its read returns.
+			 
+Parameters: -none
+			 
+Returns: 	-uint32_t - micros() of the oldest sample taken
+*******************************************************************************/
+uint32_t P1_HSC_Compare::sampleChannels(void){
+	void *sampled[HSC_COMPARE_POINTS];		//Module, or channel when it has no module
+	uint8_t numberSampled = 0;
+	uint32_t sampleTime = 0;
+	uint32_t stamp = 0;
+	void *source = NULL;
+	bool done = false;
+
+	for(int i = 0; i < count; i++){
+		P1_HSC_Channel *channel = table[i].channel;
+		source = (channel->module != NULL) ? (void *)channel->module : (void *)channel;
+
+		done = false;
+		for(int j = 0; j < numberSampled; j++){
+			if(sampled[j] == source){
+				done = true;
+			}
+		}
+		if(done){
+			continue;
+		}
+
+		if(channel->module != NULL){
+			stamp = channel->module->readSnapshot().timestamp;
+		}
+		else{
+			channel->readPosition();
+			stamp = micros();
+		}
+		if(numberSampled == 0){
+			sampleTime = stamp;		//Samples are taken in order, so the first is the oldest
+		}
+		sampled[numberSampled++] = source;
+	}
+
+	return sampleTime;
+}
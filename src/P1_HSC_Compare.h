@@ -0,0 +1,66 @@
+/*
+MIT License
+
+Copyright (c) 2023 FACTS Engineering, LLC
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef P1_HSC_Compare_h
+#define P1_HSC_Compare_h
+
+#include "P1AM.h"
+#include "P1_HSC.h"
+#include "P1_Image.h"
+
+#define HSC_COMPARE_POINTS 16	//Maximum number of setpoints per compare engine
+
+class P1_HSC_Compare{
+
+	public:
+	P1_HSC_Compare(P1_Image &outputImage);
+
+	//Setpoint Functions
+	bool addSetpoint(P1_HSC_Channel &channel, int64_t position, uint16_t outputPoint, bool stateAbove = true);	//Output point takes stateAbove at or above position
+	void clearSetpoints(void);
+	uint32_t hysteresis = 0;		//Counts below a setpoint the position must fall before it switches back
+
+	//Scan Functions
+	uint8_t run(void);				//Sample channels, fire crossed setpoints and flush outputs. Returns number of triggers
+
+	//Latency - Time from the position sample to the end of the output write
+	uint32_t lastLatency = 0;		//Microseconds for the last run that fired a trigger
+	uint32_t maxLatency = 0;		//Largest lastLatency seen
+	uint32_t triggerCount = 0;		//Total triggers fired
+
+	private:
+	struct compareSetpoint{
+		P1_HSC_Channel *channel;
+		int64_t position;
+		uint16_t point;
+		bool stateAbove;
+		bool above;					//Position was at or above the setpoint last run
+		bool started;				//Setpoint has been evaluated at least once
+	}table[HSC_COMPARE_POINTS];
+	uint8_t count = 0;
+	P1_Image *image;
+	uint32_t sampleChannels(void);
+};
+
+#endif
@@ -0,0 +1,301 @@
+/*
+MIT License
+
+Copyright (c) 2023 FACTS Engineering, LLC
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include "P1_Image.h"
+
+/*******************************************************************************
+Description: Constructor for P1_Image class. The image holds a packed copy of
+			 every discrete input and output in the base so that interlock logic
+			 can be written as word operations and sent with a single block
+			 transfer per scan.
+
+Parameters: -none
+
+Returns: 	-none
+
+Example Code: 
+*******************************************************************************/
+P1_Image::P1_Image(){
+
+	memset(inputs,0,sizeof(inputs));
+	memset(outputs,0,sizeof(outputs));
+
+}
+
+/*******************************************************************************
+Description: Size the image from the modules that signed on during P1.init() and
+			 load the current state of the discrete outputs so the first flush
+			 does not change any outputs.
+
+Parameters: -none
+
+Returns: 	-none
+
+Example Code: 
+*******************************************************************************/
+void P1_Image::begin(void){
+	moduleProps props;
+
+	inputBytes = 0;
+	outputBytes = 0;
+	for(int slot = 1; slot <= NUMBER_OF_MODULES; slot++){
+		props = P1.readSlotProps(slot);
+		inputBytes += props.diBytes;
+		outputBytes += props.doBytes;
+	}
+	inputPoints = inputBytes * 8;
+	outputPoints = outputBytes * 8;
+
+	memset(inputs,0,sizeof(inputs));
+	memset(outputs,0,sizeof(outputs));
+	if(outputBytes > 0){
+		P1.readBlockData((char *)outputs,outputBytes,0,DISCRETE_OUT_BLOCK);
+	}
+	outputsChanged = false;
+}
+
+/*******************************************************************************
+Description: Read every discrete input in the base with one block read. The block
+			 data is little endian so it is read straight into the packed words.
+
+Parameters: -none
+
+Returns: 	-uint32_t - Scan sequence number of the inputs. 0 if the read failed.
+
+Example Code: 
+*******************************************************************************/
+uint32_t P1_Image::update(void){
+	blockRegion region = {(char *)inputs, inputBytes, 0, DISCRETE_IN_BLOCK};
+	uint32_t sequence = 0;
+
+	if(inputBytes == 0){
+		return P1.getScanSequence();
+	}
+	sequence = P1.readBlockSnapshot(&region,1);
+	if(sequence != 0){
+		scanSequence = sequence;
+		timestamp = P1.getScanTimestamp();
+	}
+	return sequence;
+}
+
+/*******************************************************************************
+Description: Check if this image holds a scan the caller has not used yet. Classes
+			 that work from the image keep the sequence number of the last scan
+			 they used and call this at the top of their update. Each scan is
+			 used once, so calling their update more often than image.update
+			 does nothing, and nothing is used before the first good update.
+
+Parameters: -uint32_t &lastSequence - Sequence number of the last scan the caller
+			 used. Set to the current scan when it is new.
+
+Returns: 	-bool - true if the scan is new
+*******************************************************************************/
+bool P1_Image::isNewScan(uint32_t &lastSequence) const{
+
+	if(scanSequence == lastSequence){
+		return false;		//Already have this scan
+	}
+	lastSequence = scanSequence;
+	return true;
+
+}
+
+/*******************************************************************************
+Description: Write every discrete output in the base with one block write. Nothing
+			 is sent if no outputs have changed since the last flush.
+
+Parameters: -none
+
+Returns: 	-none
+
+Example Code: 
+*******************************************************************************/
+void P1_Image::flush(void){
+
+	if(outputsChanged && (outputBytes > 0)){
+		P1.writeBlockData((char *)outputs,outputBytes,0,DISCRETE_OUT_BLOCK);
+	}
+	outputsChanged = false;
+
+}
+
+/*******************************************************************************
+Description: Convert a slot and channel to a global point index in the image.
+
+Parameters: -uint8_t slot - Slot of the module. Slots start at 1.
+			-uint8_t channel - Channel of the module. Channels start at 1.
+
+Returns: 	-uint16_t - Point index. Point 0 is bit 0 of inputs[0] or outputs[0]
+
+Example Code: 
+*******************************************************************************/
+uint16_t P1_Image::inputPoint(uint8_t slot, uint8_t channel){
+
+	return (P1.blockOffset(slot,DISCRETE_IN_BLOCK) * 8) + (channel - 1);
+
+}
+
+uint16_t P1_Image::outputPoint(uint8_t slot, uint8_t channel){
+
+	return (P1.blockOffset(slot,DISCRETE_OUT_BLOCK) * 8) + (channel - 1);
+
+}
+
+/*******************************************************************************
+Description: Read or write a single point of the image. No bus traffic occurs.
+			 Written outputs are sent on the next flush. Points past the end of
+			 the image read as off and are not written.
+
+Parameters: -uint16_t point - Global point index
+			-bool state - State to write
+
+Returns: 	-bool - State of the point
+
+Example Code: 
+*******************************************************************************/
+bool P1_Image::readInput(uint16_t point){
+
+	if((point >> 5) >= IMAGE_DISCRETE_WORDS){
+		return false;
+	}
+	return (inputs[point >> 5] >> (point & 0x1F)) & 1;
+
+}
+
+bool P1_Image::readOutput(uint16_t point){
+
+	if((point >> 5) >= IMAGE_DISCRETE_WORDS){
+		return false;
+	}
+	return (outputs[point >> 5] >> (point & 0x1F)) & 1;
+
+}
+
+void P1_Image::writeOutput(uint16_t point, bool state){
+
+	if((point >> 5) >= IMAGE_DISCRETE_WORDS){
+		return;		//setOutputs takes an 8 bit word index, so check before it is cut down
+	}
+	if(state){
+		setOutputs(point >> 5, 1UL << (point & 0x1F));
+	}
+	else{
+		clearOutputs(point >> 5, 1UL << (point & 0x1F));
+	}
+
+}
+
+/*******************************************************************************
+Description: Set, clear or toggle up to 32 outputs at once. Interrupts are held
+			 off during the read-modify-write so an interrupt that also changes
+			 the image can not lose an update.
+
+Parameters: -uint8_t word - Index of the 32 point word. Word 0 holds points 0-31
+			-uint32_t mask - Bits to set, clear or toggle
+
+Returns: 	-none
+
+Example Code: 
+*******************************************************************************/
+void P1_Image::setOutputs(uint8_t word, uint32_t mask){
+
+	if(word >= IMAGE_DISCRETE_WORDS){
+		return;
+	}
+	noInterrupts();
+	outputs[word] |= mask;
+	outputsChanged = true;
+	interrupts();
+
+}
+
+void P1_Image::clearOutputs(uint8_t word, uint32_t mask){
+
+	if(word >= IMAGE_DISCRETE_WORDS){
+		return;
+	}
+	noInterrupts();
+	outputs[word] &= ~mask;
+	outputsChanged = true;
+	interrupts();
+
+}
+
+void P1_Image::toggleOutputs(uint8_t word, uint32_t mask){
+
+	if(word >= IMAGE_DISCRETE_WORDS){
+		return;
+	}
+	noInterrupts();
+	outputs[word] ^= mask;
+	outputsChanged = true;
+	interrupts();
+
+}
+
+/*******************************************************************************
+Description: Set, clear or toggle outputs across the whole image at once. Every
+			 word is updated before interrupts are re-enabled so the change is
+			 seen as a single update.
+
+Parameters: -const uint32_t masks[] - One mask per word. Must hold
+			 IMAGE_DISCRETE_WORDS entries.
+
+Returns: 	-none
+
+Example Code: 
+*******************************************************************************/
+void P1_Image::setOutputs(const uint32_t masks[]){
+
+	noInterrupts();
+	for(int i = 0; i < IMAGE_DISCRETE_WORDS; i++){
+		outputs[i] |= masks[i];
+	}
+	outputsChanged = true;
+	interrupts();
+
+}
+
+void P1_Image::clearOutputs(const uint32_t masks[]){
+
+	noInterrupts();
+	for(int i = 0; i < IMAGE_DISCRETE_WORDS; i++){
+		outputs[i] &= ~masks[i];
+	}
+	outputsChanged = true;
+	interrupts();
+
+}
+
+void P1_Image::toggleOutputs(const uint32_t masks[]){
+
+	noInterrupts();
+	for(int i = 0; i < IMAGE_DISCRETE_WORDS; i++){
+		outputs[i] ^= masks[i];
+	}
+	outputsChanged = true;
+	interrupts();
+
+}
@@ -0,0 +1,76 @@
+/*
+MIT License
+
+Copyright (c) 2023 FACTS Engineering, LLC
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef P1_Image_h
+#define P1_Image_h
+
+#include "P1AM.h"
+
+#define IMAGE_DISCRETE_BYTES	(NUMBER_OF_MODULES * 2)			//Up to 2 bytes (16 points) per slot
+#define IMAGE_DISCRETE_WORDS	((IMAGE_DISCRETE_BYTES + 3) / 4)	//Packed 32 points per word
+
+class P1_Image{
+
+	public:
+	P1_Image();
+
+	//Packed discrete image. Point 0 is bit 0 of word 0. Points are numbered in slot order,
+	//so the first channel of each module follows the last channel of the module before it.
+	uint32_t inputs[IMAGE_DISCRETE_WORDS];
+	uint32_t outputs[IMAGE_DISCRETE_WORDS];
+	uint16_t inputPoints = 0;		//Number of discrete input points in the base
+	uint16_t outputPoints = 0;		//Number of discrete output points in the base
+
+	//Setup
+	void begin(void);				//Size the image from the signed on modules. Call after P1.init()
+
+	//Scan Functions
+	uint32_t update(void);			//Read every discrete input in one block read. Returns scan sequence number
+	uint32_t scanSequence = 0;		//Sequence number of the last good update
+	uint32_t timestamp = 0;			//micros() at the end of the scan of the last good update
+	bool isNewScan(uint32_t &lastSequence) const;	//True once per scan for each caller. Used by update() of image-fed classes
+	void flush(void);				//Write every discrete output in one block write if any have changed
+
+	//Point Functions
+	uint16_t inputPoint(uint8_t slot, uint8_t channel);		//Global input point index of a slot/channel
+	uint16_t outputPoint(uint8_t slot, uint8_t channel);	//Global output point index of a slot/channel
+	bool readInput(uint16_t point);
+	bool readOutput(uint16_t point);
+	void writeOutput(uint16_t point, bool state);
+
+	//Mask Functions - Apply to 32 points at once. Changes are sent on the next flush
+	void setOutputs(uint8_t word, uint32_t mask);
+	void clearOutputs(uint8_t word, uint32_t mask);
+	void toggleOutputs(uint8_t word, uint32_t mask);
+	void setOutputs(const uint32_t masks[]);		//Apply masks to every word of the image at once
+	void clearOutputs(const uint32_t masks[]);
+	void toggleOutputs(const uint32_t masks[]);
+
+	private:
+	uint16_t inputBytes = 0;
+	uint16_t outputBytes = 0;
+	bool outputsChanged = false;
+};
+
+#endif
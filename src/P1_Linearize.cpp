@@ -0,0 +1,150 @@
+/*
+MIT License
+
+Copyright (c) 2023 FACTS Engineering, LLC
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include "P1_Linearize.h"
+
+/*******************************************************************************
+Description: Prepare a breakpoint table for evaluation. The slope of each segment
+			 is worked out here so evaluation needs no division. Tables with
+			 raw points spaced evenly by a power of 2 are found directly with a
+			 shift. Other tables use a binary search with a fixed number of
+			 steps. Declare tables with the LINEARIZATION macro so they are
+			 checked when the sketch is compiled. A table whose raw points do
+			 not increase, or with a segment too steep for a Q16 slope, is
+			 rejected and evaluates to 0.
+
+Parameters: -const linearPoint *points - Breakpoint table
+			-uint8_t count - Number of points
+
+Returns: 	-none
+
+Example Code: 
+*******************************************************************************/
+void P1_Linearization::begin(const linearPoint *points, uint8_t count){
+	int32_t spacing = 0;
+	int64_t rise = 0;
+	int64_t run = 0;
+	int64_t slope = 0;
+	bool uniform = true;
+
+	if(count > LINEAR_POINTS){
+		count = LINEAR_POINTS;
+	}
+	this->points = points;
+	this->count = count;
+	if(count < 2){
+		return;
+	}
+
+	minValue = points[0].value;
+	maxValue = points[0].value;
+	spacing = points[1].raw - points[0].raw;
+	for(int i = 0; i < count - 1; i++){
+		rise = ((int64_t)points[i+1].value - points[i].value) * 65536;
+		run = (int64_t)points[i+1].raw - points[i].raw;
+		if(run <= 0){
+			debugPrintln("Linearization raw points must increase");
+			this->count = 0;
+			return;
+		}
+		slope = (rise + ((rise < 0) ? -(run / 2) : (run / 2))) / run;	//Round to nearest
+		if((slope > INT32_MAX) || (slope < INT32_MIN)){
+			debugPrintln("Linearization slope is out of range");
+			this->count = 0;
+			return;
+		}
+		slopes[i] = (int32_t)slope;
+		uniform &= ((points[i+1].raw - points[i].raw) == spacing);
+		minValue = (points[i+1].value < minValue) ? points[i+1].value : minValue;
+		maxValue = (points[i+1].value > maxValue) ? points[i+1].value : maxValue;
+	}
+
+	searchStep = 1;
+	while((searchStep << 1) < (count - 1)){
+		searchStep <<= 1;
+	}
+
+	gridShift = -1;
+	if(uniform && (spacing > 0) && ((spacing & (spacing - 1)) == 0)){
+		gridShift = 0;
+		while((1L << gridShift) < spacing){
+			gridShift++;
+		}
+	}
+}
+
+/*******************************************************************************
+Description: Look up the engineering value of a raw reading. Values between two
+			 points are interpolated in fixed point. Readings outside the table
+			 return the value of the nearest end.
+
+Parameters: -int32_t raw - Counts to convert
+
+Returns: 	-int32_t - Engineering value
+
+Example Code: 
+*******************************************************************************/
+int32_t P1_Linearization::evaluate(int32_t raw) const{
+	uint8_t segment = 0;
+
+	if(count < 2){
+		return 0;
+	}
+	if(raw <= points[0].raw){
+		return points[0].value;
+	}
+	if(raw >= points[count-1].raw){
+		return points[count-1].value;
+	}
+
+	if(gridShift >= 0){
+		segment = (uint32_t)(raw - points[0].raw) >> gridShift;
+	}
+	else{
+		for(uint8_t step = searchStep; step > 0; step >>= 1){		//Same number of steps for every reading
+			if(((segment + step) < (count - 1)) && (points[segment + step].raw <= raw)){
+				segment += step;
+			}
+		}
+	}
+
+	return points[segment].value + (int32_t)((((int64_t)(raw - points[segment].raw) * slopes[segment]) + 0x8000) >> 16);
+}
+
+/*******************************************************************************
+Description: Read an analog channel with P1.readAnalog and convert it through
+			 the table.
+
+Parameters: -uint8_t slot - Slot to read from. Slots start at 1.
+			-uint8_t channel - Channel to read from. Channels start at 1.
+
+Returns: 	-int32_t - Engineering value
+
+Example Code: 
+*******************************************************************************/
+int32_t P1_Linearization::readAnalog(uint8_t slot, uint8_t channel) const{
+
+	return evaluate(P1.readAnalog(slot,channel));
+
+}
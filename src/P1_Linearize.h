@@ -0,0 +1,70 @@
+/*
+MIT License
+
+Copyright (c) 2023 FACTS Engineering, LLC
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef P1_Linearize_h
+#define P1_Linearize_h
+
+#include "P1AM.h"
+
+#define LINEAR_POINTS 32		//Maximum breakpoints per table
+
+struct linearPoint{				//One breakpoint of a piecewise linear table
+	int32_t raw;				//Counts. Must increase from one point to the next
+	int32_t value;				//Engineering value at raw
+};
+
+//Compile time check of a breakpoint table. True if it has 2 to LINEAR_POINTS points and raw strictly increases.
+template<size_t N>
+constexpr bool linearTableValid(const linearPoint (&points)[N], size_t i = 1){
+	return (N >= 2) && (N <= LINEAR_POINTS) && ((i >= N) || ((points[i].raw > points[i-1].raw) && linearTableValid(points, i + 1)));
+}
+
+//Declare a P1_Linearization for a constexpr table and fail the build if the table is not valid.
+#define LINEAR_TEXT(x) #x
+#define LINEAR_VALUE_TEXT(x) LINEAR_TEXT(x)	//Expand x before turning it into text
+#define LINEARIZATION(name, table) \
+	static_assert(linearTableValid(table), #table " must have 2 to " LINEAR_VALUE_TEXT(LINEAR_POINTS) " points with raw strictly increasing"); \
+	P1_Linearization name(table)
+
+class P1_Linearization{
+
+	public:
+	template<size_t N>
+	P1_Linearization(const linearPoint (&points)[N]){ begin(points, N); }
+
+	int32_t evaluate(int32_t raw) const;			//Engineering value of raw. Clamped to the ends of the table
+	int32_t readAnalog(uint8_t slot, uint8_t channel) const;	//P1.readAnalog through the table
+	int32_t minValue = 0;			//Smallest value in the table
+	int32_t maxValue = 0;			//Largest value in the table
+
+	private:
+	const linearPoint *points;
+	uint8_t count = 0;
+	uint8_t searchStep = 0;			//Largest power of 2 below the number of segments
+	int8_t gridShift = -1;			//log2 of the raw spacing if the points are evenly spaced by a power of 2
+	int32_t slopes[LINEAR_POINTS - 1];	//Q16 value per count of each segment
+	void begin(const linearPoint *points, uint8_t count);
+};
+
+#endif
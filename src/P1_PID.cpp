@@ -0,0 +1,395 @@
+/*
+MIT License
+
+Copyright (c) 2023 FACTS Engineering, LLC
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include "P1_PID.h"
+
+/*******************************************************************************
+Description: Constructor for P1_PID class. Runs a bank of PID loops from the
+			 image of a P1_Scan. Each loop samples on a fixed time grid taken
+			 from the scan timestamps, so its sample time does not drift with
+			 whatever else loop() does, and the gains are folded with the
+			 sample time once at setup. The math is fixed point so no floating
+			 point is done per sample on the P1AM-100. Outputs are staged in
+			 the scan and sent with the rest of the outputs on scan.flush().
+
+Parameters: -P1_Scan &scan - Scan holding the input and output image
+
+Returns: 	-none
+
+Example Code: 
+*******************************************************************************/
+P1_PID::P1_PID(P1_Scan &scan){
+
+	this->scan = &scan;
+	memset(table,0,sizeof(table));
+
+}
+
+/*******************************************************************************
+Description: Add a loop. The process variable is an analog input channel in
+			 counts. The output is an analog output channel in counts or the
+			 duty cycle of a PWM channel in hundredths of a percent. Output
+			 limits default to the module range. The loop starts in manual
+			 holding the output's current value, so calling setAuto is bumpless.
+
+Parameters: -uint8_t pvSlot - Slot of the analog input module. Slots start at 1.
+			-uint8_t pvChannel - Channel of the analog input. Channels start at 1.
+			-uint8_t outSlot - Slot of the analog output or PWM module
+			-uint8_t outChannel - Channel of the output
+			-uint32_t sampleTime - Milliseconds between samples. Samples happen
+			 on the first scan at or after each sample time.
+
+Returns: 	-int8_t - Index of the loop. -1 on failure.
+
+Example Code: 
+*******************************************************************************/
+int8_t P1_PID::addLoop(uint8_t pvSlot, uint8_t pvChannel, uint8_t outSlot, uint8_t outChannel, uint32_t sampleTime){
+	slotImage *pv = NULL;
+	slotImage *out = NULL;
+	pidLoop *loop;
+	uint8_t bits = 0;
+
+	if(count >= PID_LOOPS){
+		debugPrintln("No room for another loop");
+		return -1;
+	}
+	if(sampleTime == 0){
+		debugPrintln("Sample time is not valid");
+		return -1;
+	}
+	if(!scan->analogChannel(pvSlot,pvChannel).valid()){
+		return -1;
+	}
+	pv = scan->getSlot(pvSlot);
+	if(pvChannel > (pv->props.aiBytes / 4)){
+		debugPrintln("This channel is not valid");
+		return -1;
+	}
+
+	loop = &table[count];
+	memset(loop,0,sizeof(pidLoop));
+	out = scan->getSlot(outSlot);
+	if((out != NULL) && (out->driver != NULL) && (out->driver->family() == DRIVER_PWM)){
+		if(!scan->pwmChannel(outSlot,outChannel).valid()){
+			return -1;
+		}
+		loop->outIndex = (outChannel - 1) * 2;		//Duty register
+		loop->outMax = 10000;
+	}
+	else{
+		if(!scan->analogChannel(outSlot,outChannel).valid()){
+			return -1;
+		}
+		if(outChannel > (out->props.aoBytes / 4)){
+			debugPrintln("This channel is not valid");
+			return -1;
+		}
+		bits = out->props.dataSize;
+		loop->outIndex = outChannel - 1;
+		loop->outMax = ((bits > 0) && (bits <= 24)) ? (1L << bits) - 1 : 0xFFFF;
+	}
+
+	loop->pv = pv;
+	loop->pvIndex = pvChannel - 1;
+	loop->out = out;
+	loop->period = sampleTime * 1000;
+	loop->output = (int32_t)out->outputValues[loop->outIndex];
+	loop->integral = (int64_t)loop->output * 65536;
+	return count++;
+}
+
+/*******************************************************************************
+Description: Set the gains of a loop. The loop is in parallel form and the
+			 derivative acts on the process variable, so a setpoint change does
+			 not kick the output. Retuning a running loop is bumpless because
+			 the integral is kept in output units.
+
+Parameters: -uint8_t index - Index returned by addLoop
+			-float kp - Proportional gain in output units per count of error
+			-float ki - Integral gain in output units per count of error per second
+			-float kd - Derivative gain in output units per count per second of
+			 process variable change
+
+Returns: 	-bool - false if a gain is negative or too large for the fixed point
+			 math. Use setReverse for a reverse acting loop.
+
+Example Code: 
+*******************************************************************************/
+bool P1_PID::setTuning(uint8_t index, float kp, float ki, float kd){
+	double seconds = 0;
+	double p = 0;
+	double i = 0;
+	double d = 0;
+
+	if(index >= count){
+		return false;
+	}
+
+	seconds = table[index].period / 1000000.0;
+	p = kp * 65536.0;
+	i = ki * seconds * 65536.0;
+	d = kd / seconds * 65536.0;
+	if((p < 0) || (i < 0) || (d < 0) || (p > INT32_MAX) || (i > INT32_MAX) || (d > INT32_MAX)){
+		debugPrintln("Gain is not valid");
+		return false;
+	}
+
+	table[index].p = (int32_t)(p + 0.5);
+	table[index].i = (int32_t)(i + 0.5);
+	table[index].d = (int32_t)(d + 0.5);
+	return true;
+}
+
+/*******************************************************************************
+Description: Limit the output of a loop. The integral stops where the output
+			 reaches a limit while the error pushes further, so it does not
+			 wind up.
+
+Parameters: -uint8_t index - Index returned by addLoop
+			-int32_t outMin - Lowest output in counts or hundredths of a percent
+			-int32_t outMax - Highest output
+
+Returns: 	-bool - false if outMin is not below outMax
+
+Example Code: 
+*******************************************************************************/
+bool P1_PID::setOutputLimits(uint8_t index, int32_t outMin, int32_t outMax){
+
+	if((index >= count) || (outMin >= outMax)){
+		debugPrintln("Output limits are not valid");
+		return false;
+	}
+	table[index].outMin = outMin;
+	table[index].outMax = outMax;
+	return true;
+}
+
+void P1_PID::setReverse(uint8_t index, bool reverse){
+
+	if(index < count){
+		table[index].reverse = reverse;
+	}
+
+}
+
+/*******************************************************************************
+Description: Run every loop that is due on the latest scan. Each loop keeps a
+			 fixed sample grid. If a sample is late by more
+			 than a whole sample time the grid restarts and overruns counts it.
+			 A loop whose process variable is not QUALITY_GOOD holds its output.
+
+Parameters: -none
+
+Returns: 	-none
+
+Example Code: 
+*******************************************************************************/
+void P1_PID::update(void){
+	pidLoop *loop;
+	uint32_t now = 0;
+
+	if(!scan->isNewScan(lastSequence)){
+		return;
+	}
+	now = scan->timestamp;
+
+	for(int n = 0; n < count; n++){
+		loop = &table[n];
+		if(!loop->started){
+			loop->nextSample = now;
+			loop->started = true;
+		}
+		if((int32_t)(now - loop->nextSample) < 0){
+			continue;		//Not due yet
+		}
+		loop->nextSample += loop->period;
+		if((int32_t)(now - loop->nextSample) >= 0){
+			loop->nextSample = now + loop->period;	//Fell behind. Don't try to catch up
+			overruns++;
+		}
+		sample(*loop);
+	}
+}
+
+void P1_PID::setSetpoint(uint8_t index, int32_t setpoint){
+
+	if(index < count){
+		table[index].setpoint = setpoint;
+	}
+
+}
+
+/*******************************************************************************
+Description: Put a loop in manual and hold its output. The integral is set from
+			 the output right away and keeps tracking it on every sample, so
+			 the loop picks up from it whenever setAuto is called.
+
+Parameters: -uint8_t index - Index returned by addLoop
+			-int32_t output - Output in counts or hundredths of a percent.
+			 Limited to the output limits.
+
+Returns: 	-none
+
+Example Code: 
+*******************************************************************************/
+void P1_PID::setManual(uint8_t index, int32_t output){
+	pidLoop *loop;
+
+	if(index >= count){
+		return;
+	}
+	loop = &table[index];
+	output = (output < loop->outMin) ? loop->outMin : ((output > loop->outMax) ? loop->outMax : output);
+	loop->automatic = false;
+	writeOutput(*loop,output);
+	track(*loop);
+}
+
+/*******************************************************************************
+Description: Put a loop back in auto. If it was in manual the integral is set
+			 so the first auto sample starts from the held output, even if no
+			 sample ran since setManual or addLoop.
+
+Parameters: -uint8_t index - Index returned by addLoop
+
+Returns: 	-none
+
+Example Code: 
+*******************************************************************************/
+void P1_PID::setAuto(uint8_t index){
+
+	if((index >= count) || table[index].automatic){
+		return;
+	}
+	track(table[index]);
+	table[index].automatic = true;
+}
+
+bool P1_PID::isAuto(uint8_t index){
+
+	return (index < count) && table[index].automatic;
+
+}
+
+int32_t P1_PID::readOutput(uint8_t index){
+
+	return (index < count) ? table[index].output : 0;
+
+}
+
+int32_t P1_PID::readError(uint8_t index){
+
+	return (index < count) ? table[index].error : 0;
+
+}
+
+/*******************************************************************************
+Description: Set the integral so the loop's output equals its current output,
+			 limited to the output limits, with the latest process variable. Used when switching modes. If
+			 the process variable is not QUALITY_GOOD the integral is set to
+			 the output and the next sample starts without a derivative.
+
+Parameters: -pidLoop &loop - Loop to set
+
+Returns: 	-none
+*******************************************************************************/
+void P1_PID::track(pidLoop &loop){
+	int32_t pv = 0;
+	int32_t error = 0;
+
+	loop.output = (loop.output < loop.outMin) ? loop.outMin : ((loop.output > loop.outMax) ? loop.outMax : loop.output);
+	if(loop.pv->quality[loop.pvIndex] != QUALITY_GOOD){
+		loop.integral = (int64_t)loop.output * 65536;
+		loop.primed = false;
+		return;
+	}
+
+	pv = (int32_t)loop.pv->inputValues[loop.pvIndex];
+	loop.error = loop.setpoint - pv;
+	error = loop.reverse ? -loop.error : loop.error;
+	loop.integral = (int64_t)loop.output * 65536 - (int64_t)loop.p * error;
+	loop.lastPv = pv;
+	loop.primed = true;
+}
+
+void P1_PID::sample(pidLoop &loop){
+	int32_t pv = 0;
+	int32_t error = 0;
+	int32_t change = 0;
+	int64_t p = 0;
+	int64_t d = 0;
+	int64_t integral = 0;
+	int64_t u = 0;
+	int64_t low = (int64_t)loop.outMin * 65536;
+	int64_t high = (int64_t)loop.outMax * 65536;
+
+	if(loop.pv->quality[loop.pvIndex] != QUALITY_GOOD){
+		loop.primed = false;		//Hold the output. No derivative kick when the input comes back
+		return;
+	}
+
+	pv = (int32_t)loop.pv->inputValues[loop.pvIndex];
+	loop.error = loop.setpoint - pv;
+	change = loop.primed ? pv - loop.lastPv : 0;
+	loop.lastPv = pv;
+	loop.primed = true;
+
+	error = loop.reverse ? -loop.error : loop.error;
+	change = loop.reverse ? -change : change;
+	p = (int64_t)loop.p * error;		//Q16 output units
+	d = -(int64_t)loop.d * change;
+
+	if(loop.automatic){
+		integral = loop.integral + (int64_t)loop.i * error;
+		u = p + integral + d;
+		if((u > high) && (error > 0)){
+			integral = high - p - d;		//Only integrate up to the limit
+			integral = (integral < loop.integral) ? loop.integral : integral;
+		}
+		else if((u < low) && (error < 0)){
+			integral = low - p - d;
+			integral = (integral > loop.integral) ? loop.integral : integral;
+		}
+	}
+	else{
+		integral = (int64_t)loop.output * 65536 - p - d;	//Track the manual output
+	}
+	loop.integral = integral;
+
+	if(loop.automatic){
+		u = p + integral + d;
+		u = (u < low) ? low : ((u > high) ? high : u);
+		writeOutput(loop,(int32_t)((u + 0x8000) >> 16));
+	}
+}
+
+void P1_PID::writeOutput(pidLoop &loop, int32_t output){
+
+	if(output == loop.output){
+		return;		//Nothing new to flush
+	}
+	loop.output = output;
+	loop.out->outputValues[loop.outIndex] = (uint32_t)output;
+	loop.out->outputsChanged = true;
+}
@@ -0,0 +1,85 @@
+/*
+MIT License
+
+Copyright (c) 2023 FACTS Engineering, LLC
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef P1_PID_h
+#define P1_PID_h
+
+#include "P1AM.h"
+#include "P1_Scan.h"
+
+#define PID_LOOPS	8			//Maximum number of loops per PID bank
+
+class P1_PID{
+
+	public:
+	P1_PID(P1_Scan &scan);
+
+	//Setup - Returns the index of the loop or -1 on failure. Call after scan.begin()
+	int8_t addLoop(uint8_t pvSlot, uint8_t pvChannel, uint8_t outSlot, uint8_t outChannel, uint32_t sampleTime);	//Output is an analog output or PWM duty. Sample time in ms
+	bool setTuning(uint8_t index, float kp, float ki, float kd);	//Output units per count, per count second and second per count
+	bool setOutputLimits(uint8_t index, int32_t outMin, int32_t outMax);
+	void setReverse(uint8_t index, bool reverse);	//Output goes down when the process variable is below setpoint
+
+	//Scan Functions
+	void update(void);				//Run every loop that is due. Call after scan.update() and before scan.flush()
+	void setSetpoint(uint8_t index, int32_t setpoint);	//Counts of the process variable
+	void setManual(uint8_t index, int32_t output);		//Hold the output. The loop tracks it for a bumpless return to auto
+	void setAuto(uint8_t index);
+	bool isAuto(uint8_t index);
+	int32_t readOutput(uint8_t index);	//Counts or duty in hundredths of a percent
+	int32_t readError(uint8_t index);	//Setpoint minus process variable at the last sample
+	uint16_t overruns = 0;			//Samples that were late by more than a sample time
+
+	private:
+	struct pidLoop{
+		slotImage *pv;
+		uint8_t pvIndex;			//Register of the process variable
+		slotImage *out;
+		uint8_t outIndex;			//Register of the output. Duty register for PWM
+		uint32_t period;			//Sample time in microseconds
+		uint32_t nextSample;
+		bool started;
+		bool primed;				//lastPv is valid
+		bool automatic;
+		bool reverse;
+		int32_t setpoint;
+		int32_t outMin;
+		int32_t outMax;
+		int32_t p;					//Q16 gains folded with the sample time
+		int32_t i;
+		int32_t d;
+		int64_t integral;			//Q16 output units. Stored in output units so retuning is bumpless
+		int32_t lastPv;
+		int32_t error;
+		int32_t output;
+	}table[PID_LOOPS];
+	P1_Scan *scan;
+	uint8_t count = 0;
+	uint32_t lastSequence = 0;
+	void sample(pidLoop &loop);
+	void track(pidLoop &loop);
+	void writeOutput(pidLoop &loop, int32_t output);
+};
+
+#endif
@@ -0,0 +1,394 @@
+/*
+MIT License
+
+Copyright (c) 2023 FACTS Engineering, LLC
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include "P1_PWM.h"
+
+/*******************************************************************************	
+Description: Constructor for P1_PWM_Module class. Holds the duty cycle and
+			 frequency of all 4 channels of a P1-04PWM so they can be sent
+			 together with one block write. Channels that have not changed
+			 since the last write are left out.
+			 
+Parameters: -uint8_t slotSelect - Slot the module is in. Slots start at 1.
+			 
+Returns: 	-none
+
+Example Code: 
+*******************************************************************************/
+P1_PWM_Module::P1_PWM_Module(uint8_t slotSelect){
+
+	slotNumber = slotSelect;
+	memset(dutyStaged,0,sizeof(dutyStaged));
+	memset(freqStaged,0,sizeof(freqStaged));
+	memset(dutySent,0,sizeof(dutySent));
+	memset(freqSent,0,sizeof(freqSent));
+
+}
+
+/*******************************************************************************	
+Description: Stage the duty cycle and/or frequency of a channel. Nothing is sent
+			 until update is called.
+			 
+Parameters: -uint8_t channel - Channel to set. Channels start at 1.
+			-float duty - Duty cycle. Range 0.00-100.00. You can include up to 2 decimal places
+			-uint32_t freq - Frequency. See module data sheet for range. P1-04PWM is 0-20kHz.
+			 
+Returns: 	-none
+
+Example Code: 
+*******************************************************************************/
+void P1_PWM_Module::setDuty(uint8_t channel, float duty){
+
+	if((channel <= 0) || (channel > PWM_CHANNELS)){
+		debugPrintln("This channel is not valid");
+		return;
+	}
+	dutyStaged[channel-1] = (uint32_t)(duty * 100 + 0.5f);// shift decimal over 2 places and round. e.g. 12.3456 turns into 1235
+
+}
+
+/*******************************************************************************	
+Description: Stage the duty cycle of a channel in hundredths of a percent, so
+			 no float math is needed. Nothing is sent until update is called.
+			 
+Parameters: -uint8_t channel - Channel to set. Channels start at 1.
+			-uint16_t duty - Duty cycle. Range 0-10000. e.g. 1234 is 12.34%
+			 
+Returns: 	-none
+
+Example Code: 
+*******************************************************************************/
+void P1_PWM_Module::setDutyFixed(uint8_t channel, uint16_t duty){
+
+	if((channel <= 0) || (channel > PWM_CHANNELS)){
+		debugPrintln("This channel is not valid");
+		return;
+	}
+	dutyStaged[channel-1] = duty;
+
+}
+
+void P1_PWM_Module::setFreq(uint8_t channel, uint32_t freq){
+
+	if((channel <= 0) || (channel > PWM_CHANNELS)){
+		debugPrintln("This channel is not valid");
+		return;
+	}
+	freqStaged[channel-1] = freq;
+
+}
+
+void P1_PWM_Module::set(uint8_t channel, float duty, uint32_t freq){
+
+	setDuty(channel,duty);
+	setFreq(channel,freq);
+
+}
+
+/*******************************************************************************	
+Description: Send the staged duty cycle and frequency of every changed channel in
+			 one block write. The write covers the span from the first to the last
+			 changed channel. Nothing is sent if no channel has changed.
+			 
+Parameters: -none
+			 
+Returns: 	-uint8_t - Number of channels in the write. 0 if nothing was sent
+
+Example Code: 
+*******************************************************************************/
+uint8_t P1_PWM_Module::update(void){
+	char tData[PWM_CHANNELS * 8];
+	int32_t registers[PWM_CHANNELS * 2];
+	int first = -1;
+	int last = -1;
+
+	for(int i = 0; i < PWM_CHANNELS; i++){
+		if(!(sentChannels & (1 << i)) || (dutyStaged[i] != dutySent[i]) || (freqStaged[i] != freqSent[i])){
+			if(first < 0){
+				first = i;
+			}
+			last = i;
+		}
+	}
+	if(first < 0){
+		return 0;		//Nothing changed
+	}
+
+	if(offset < 0){		//Check the module and find its offset once
+		if(!checkIfPWM()){
+			return 0;
+		}
+		offset = P1.blockOffset(slotNumber,ANALOG_OUT_BLOCK);
+	}
+
+	for(int i = first; i <= last; i++){
+		registers[(i - first) * 2] = dutyStaged[i];		//Each channel uses 2 registers. Duty then frequency
+		registers[((i - first) * 2) + 1] = freqStaged[i];
+		dutySent[i] = dutyStaged[i];
+		freqSent[i] = freqStaged[i];
+		sentChannels |= 1 << i;
+	}
+
+	encodeAnalogBlock(registers,(uint8_t *)tData,(last - first + 1) * 2);
+	P1.writeBlockData(tData,(last - first + 1) * 8,offset + (first * 8),ANALOG_OUT_BLOCK);
+	return last - first + 1;
+}
+
+/*******************************************************************************	
+Description: Stage and send the duty cycle and frequency of all 4 channels.
+			 
+Parameters: -const float duty[] - 4 duty cycles. Range 0.00-100.00
+			-const uint32_t freq[] - 4 frequencies
+			 
+Returns: 	-uint8_t - Number of channels in the write. 0 if nothing changed
+
+Example Code: 
+*******************************************************************************/
+uint8_t P1_PWM_Module::writeAll(const float duty[], const uint32_t freq[]){
+
+	for(int i = 0; i < PWM_CHANNELS; i++){
+		set(i + 1,duty[i],freq[i]);
+	}
+	return update();
+}
+
+bool P1_PWM_Module::checkIfPWM(void){
+
+	const P1_Driver *driver = P1.readSlotDriver(slotNumber);
+
+	if((driver == NULL) || (driver->family() != DRIVER_PWM)){		//Is this PWM
+		debugPrint("Slot ");
+		debugPrint(slotNumber);
+		debugPrintln(": This module is not a PWM module");
+		return false;
+	}
+	return true;
+}
+
+/*******************************************************************************	
+Description: Constructor for P1_PWM_Profile class. Steps the duty cycle and
+			 frequency of P1-04PWM channels along linear or S-curve ramps at a
+			 fixed update period, independent of how fast loop() runs. A channel
+			 is only written when the output has fallen more than the tolerance
+			 behind its profile, and all channels due in the same update share
+			 one block write.
+			 
+Parameters: -P1_PWM_Module &pwmModule - Module to drive
+			 
+Returns: 	-none
+
+Example Code: 
+*******************************************************************************/
+P1_PWM_Profile::P1_PWM_Profile(P1_PWM_Module &pwmModule){
+
+	module = &pwmModule;
+	memset(ramps,0,sizeof(ramps));
+
+}
+
+/*******************************************************************************	
+Description: Ramp a channel from its current value to a new duty cycle and
+			 frequency over a set time.
+			 
+Parameters: -uint8_t channel - Channel to ramp. Channels start at 1.
+			-float duty - Target duty cycle. Range 0.00-100.00
+			-uint32_t freq - Target frequency in Hz
+			-uint32_t rampTime - Milliseconds to reach the target
+			-uint8_t shape - PWM_RAMP_LINEAR or PWM_RAMP_SCURVE
+			 
+Returns: 	-none
+
+Example Code: 
+*******************************************************************************/
+void P1_PWM_Profile::rampTo(uint8_t channel, float duty, uint32_t freq, uint32_t rampTime, uint8_t shape){
+	pwmRamp *ramp;
+
+	if((channel <= 0) || (channel > PWM_CHANNELS)){
+		debugPrintln("This channel is not valid");
+		return;
+	}
+
+	ramp = &ramps[channel-1];
+	ramp->startDuty = module->dutyStaged[channel-1];
+	ramp->startFreq = module->freqStaged[channel-1];
+	ramp->targetDuty = (uint32_t)(duty * 100 + 0.5f);
+	ramp->targetFreq = freq;
+	ramp->startTime = millis();
+	ramp->duration = rampTime;
+	ramp->shape = shape;
+	ramp->active = true;
+}
+
+/*******************************************************************************	
+Description: Ramp a channel to a new duty cycle at a fixed rate. The frequency
+			 changes linearly over the same time.
+			 
+Parameters: -uint8_t channel - Channel to ramp. Channels start at 1.
+			-float duty - Target duty cycle. Range 0.00-100.00
+			-uint32_t freq - Target frequency in Hz
+			-float dutyPerSecond - Ramp rate in percent per second
+			 
+Returns: 	-none
+
+Example Code: 
+*******************************************************************************/
+void P1_PWM_Profile::rampRate(uint8_t channel, float duty, uint32_t freq, float dutyPerSecond){
+	float change = 0;
+
+	if((channel <= 0) || (channel > PWM_CHANNELS)){
+		debugPrintln("This channel is not valid");
+		return;
+	}
+	if(dutyPerSecond <= 0){
+		debugPrintln("Ramp rate is not valid");
+		return;
+	}
+
+	change = duty - (module->dutyStaged[channel-1] / 100.0f);
+	if(change < 0){
+		change = -change;
+	}
+	rampTo(channel,duty,freq,(uint32_t)(change * 1000 / dutyPerSecond),PWM_RAMP_LINEAR);
+}
+
+void P1_PWM_Profile::stop(uint8_t channel){
+
+	if((channel > 0) && (channel <= PWM_CHANNELS)){
+		ramps[channel-1].active = false;
+	}
+
+}
+
+bool P1_PWM_Profile::isRamping(uint8_t channel){
+
+	if((channel <= 0) || (channel > PWM_CHANNELS)){
+		return false;
+	}
+	return ramps[channel-1].active;
+
+}
+
+/*******************************************************************************	
+Description: Step every active profile. Does nothing until updatePeriod has passed
+			 since the last step. Updates are scheduled on a fixed grid so the
+			 period does not drift with loop timing.
+			 
+Parameters: -none
+			 
+Returns: 	-bool - true if the module was written
+
+Example Code: 
+*******************************************************************************/
+bool P1_PWM_Profile::run(void){
+	uint32_t now = millis();
+	uint32_t elapsed = 0;
+	uint32_t fraction = 0;
+	uint32_t duty = 0;
+	uint32_t freq = 0;
+	uint32_t dutyError = 0;
+	uint32_t freqError = 0;
+	bool ramping = false;
+	bool changed = false;
+
+	for(int i = 0; i < PWM_CHANNELS; i++){
+		ramping |= ramps[i].active;
+	}
+	if(!ramping){
+		scheduled = false;
+		return false;
+	}
+	naiveWrites++;		//A per-loop update would write every call while ramping
+
+	if(!scheduled){
+		nextUpdate = now;
+		scheduled = true;
+	}
+	if((int32_t)(now - nextUpdate) < 0){
+		return false;
+	}
+	nextUpdate += updatePeriod;
+	if((int32_t)(now - nextUpdate) >= 0){
+		nextUpdate = now + updatePeriod;	//Fell behind. Don't try to catch up
+	}
+
+	for(int i = 0; i < PWM_CHANNELS; i++){
+		pwmRamp *ramp = &ramps[i];
+		if(!ramp->active){
+			continue;
+		}
+
+		elapsed = now - ramp->startTime;
+		if(elapsed >= ramp->duration){
+			duty = ramp->targetDuty;
+			freq = ramp->targetFreq;
+			ramp->active = false;
+		}
+		else{
+			fraction = ((uint64_t)elapsed << 16) / ramp->duration;	//0-65535 through the ramp
+			if(ramp->shape == PWM_RAMP_SCURVE){
+				uint32_t f2 = (fraction * fraction) >> 16;
+				uint32_t f3 = (f2 * fraction) >> 16;
+				fraction = (3 * f2) - (2 * f3);		//Smoothstep 3t^2 - 2t^3
+			}
+			duty = interpolate(ramp->startDuty,ramp->targetDuty,fraction);
+			freq = interpolate(ramp->startFreq,ramp->targetFreq,fraction);
+		}
+
+		dutyError = (duty > module->dutyStaged[i]) ? duty - module->dutyStaged[i] : module->dutyStaged[i] - duty;
+		freqError = (freq > module->freqStaged[i]) ? freq - module->freqStaged[i] : module->freqStaged[i] - freq;
+		if((dutyError > dutyTolerance) || (freqError > freqTolerance) || (!ramp->active && (dutyError || freqError))){
+			module->dutyStaged[i] = duty;
+			module->freqStaged[i] = freq;
+			changed = true;
+		}
+	}
+
+	if(changed && (module->update() > 0)){
+		busWrites++;
+		return true;
+	}
+	return false;
+}
+
+/*******************************************************************************	
+Description: Number of block writes saved compared with writing the module on
+			 every run call while a ramp is active.
+			 
+Parameters: -none
+			 
+Returns: 	-uint32_t - naiveWrites minus busWrites
+
+Example Code: 
+*******************************************************************************/
+uint32_t P1_PWM_Profile::writesSaved(void){
+
+	return (naiveWrites > busWrites) ? naiveWrites - busWrites : 0;
+
+}
+
+uint32_t P1_PWM_Profile::interpolate(uint32_t start, uint32_t target, uint32_t fraction){
+
+	return (uint32_t)((int64_t)start + ((((int64_t)target - (int64_t)start) * fraction) >> 16));
+
+}
@@ -0,0 +1,103 @@
+/*
+MIT License
+
+Copyright (c) 2023 FACTS Engineering, LLC
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef P1_PWM_h
+#define P1_PWM_h
+
+#include "P1AM.h"
+
+#define PWM_CHANNELS 4			//Channels on a P1-04PWM
+
+#define PWM_RAMP_LINEAR 0		//Constant rate ramp
+#define PWM_RAMP_SCURVE 1		//Smooth start and stop. Peak rate is 1.5x the linear rate
+
+class P1_PWM_Module{
+
+	public:
+	P1_PWM_Module(uint8_t slotSelect);
+
+	//Staging Functions - Values are sent on the next update
+	void setDuty(uint8_t channel, float duty);				//Duty cycle 0.00-100.00
+	void setDutyFixed(uint8_t channel, uint16_t duty);		//Duty cycle in hundredths of a percent. 0-10000
+	void setFreq(uint8_t channel, uint32_t freq);			//Frequency in Hz
+	void set(uint8_t channel, float duty, uint32_t freq);
+
+	//Module Functions
+	uint8_t update(void);									//Send changed channels in one block write. Returns number of channels sent
+	uint8_t writeAll(const float duty[], const uint32_t freq[]);	//Stage and send all 4 channels
+
+	private:
+	friend class P1_PWM_Profile;
+	uint8_t slotNumber = 0;
+	uint32_t dutyStaged[PWM_CHANNELS];		//Duty in hundredths of a percent
+	uint32_t freqStaged[PWM_CHANNELS];
+	uint32_t dutySent[PWM_CHANNELS];
+	uint32_t freqSent[PWM_CHANNELS];
+	uint8_t sentChannels = 0;				//Bit 0 is channel 1. Set once a channel has been written
+	int16_t offset = -1;					//Analog output offset. Found on the first update
+	bool checkIfPWM(void);
+};
+
+class P1_PWM_Profile{
+
+	public:
+	P1_PWM_Profile(P1_PWM_Module &pwmModule);
+
+	//Profile Functions - Ramps start from the last value staged on the channel
+	void rampTo(uint8_t channel, float duty, uint32_t freq, uint32_t rampTime, uint8_t shape = PWM_RAMP_LINEAR);	//Reach duty/freq after rampTime ms
+	void rampRate(uint8_t channel, float duty, uint32_t freq, float dutyPerSecond);							//Linear ramp at a fixed duty rate
+	void stop(uint8_t channel);			//Hold the channel at its current value
+	bool isRamping(uint8_t channel);
+
+	//Settings
+	uint16_t updatePeriod = 10;			//Milliseconds between output updates
+	uint16_t dutyTolerance = 10;		//Hundredths of a percent the output may lag the profile before it is written
+	uint32_t freqTolerance = 10;		//Hz the output may lag the profile before it is written
+
+	//Scan Functions
+	bool run(void);						//Call every loop. Steps the profiles once per updatePeriod. Returns true if it wrote the module
+
+	//Statistics
+	uint32_t busWrites = 0;				//Block writes sent
+	uint32_t naiveWrites = 0;			//Writes a per-loop update would have sent while ramping
+	uint32_t writesSaved(void);
+
+	private:
+	struct pwmRamp{
+		uint32_t startDuty;
+		uint32_t targetDuty;
+		uint32_t startFreq;
+		uint32_t targetFreq;
+		uint32_t startTime;
+		uint32_t duration;
+		uint8_t shape;
+		bool active;
+	}ramps[PWM_CHANNELS];
+	P1_PWM_Module *module;
+	uint32_t nextUpdate = 0;
+	bool scheduled = false;
+	uint32_t interpolate(uint32_t start, uint32_t target, uint32_t fraction);
+};
+
+#endif
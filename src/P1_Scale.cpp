@@ -0,0 +1,325 @@
+/*
+MIT License
+
+Copyright (c) 2023 FACTS Engineering, LLC
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include "P1_Scale.h"
+
+/*******************************************************************************
+Description: Constructor for P1_Scaling class. Converts the analog channels of a
+			 P1_Scan between counts and engineering units. All division is done
+			 once when a channel is added, so each conversion during the scan is
+			 one multiply and add in fixed point.
+
+			 Engineering units are integers. Pick a unit small enough for the
+			 resolution needed, e.g. 0.01 PSI per unit for a 0-100.00 PSI sensor
+			 is engLow 0 and engHigh 10000.
+
+Parameters: -P1_Scan &scan - Scan holding the analog image
+
+Returns: 	-none
+
+Example Code: 
+*******************************************************************************/
+P1_Scaling::P1_Scaling(P1_Scan &scan){
+
+	this->scan = &scan;
+	memset(table,0,sizeof(table));
+	memset(values,0,sizeof(values));
+
+}
+
+/*******************************************************************************
+Description: Scale an analog input channel. Without a raw range the full count
+			 range of the module's resolution is used, e.g. 0-4095 for a
+			 12 bit module.
+
+Parameters: -uint8_t slot - Slot of the module. Slots start at 1.
+			-uint8_t channel - Channel of the module. Channels start at 1.
+			-int32_t rawLow - Counts at engLow
+			-int32_t rawHigh - Counts at engHigh
+			-int32_t engLow - Engineering value at rawLow
+			-int32_t engHigh - Engineering value at rawHigh
+			-bool clamp - Keep values inside engLow to engHigh
+
+Returns: 	-int8_t - Index of the scaled channel. -1 on failure.
+
+Example Code: 
+*******************************************************************************/
+int8_t P1_Scaling::addInput(uint8_t slot, uint8_t channel, int32_t engLow, int32_t engHigh, bool clamp){
+
+	return addChannel(slot,channel,false,0,moduleRange(slot),engLow,engHigh,clamp);
+
+}
+
+int8_t P1_Scaling::addInput(uint8_t slot, uint8_t channel, int32_t rawLow, int32_t rawHigh, int32_t engLow, int32_t engHigh, bool clamp){
+
+	return addChannel(slot,channel,false,rawLow,rawHigh,engLow,engHigh,clamp);
+
+}
+
+/*******************************************************************************
+Description: Convert an analog input channel through a piecewise linear table
+			 instead of a straight line. A calibration set with calibrate is
+			 applied to the table value.
+
+Parameters: -uint8_t slot - Slot of the module. Slots start at 1.
+			-uint8_t channel - Channel of the module. Channels start at 1.
+			-const P1_Linearization &curve - Table declared with LINEARIZATION
+
+Returns: 	-int8_t - Index of the scaled channel. -1 on failure.
+
+Example Code: 
+*******************************************************************************/
+int8_t P1_Scaling::addInput(uint8_t slot, uint8_t channel, const P1_Linearization &curve){
+	int8_t index = 0;
+
+	index = addChannel(slot,channel,false,0,1,curve.minValue,curve.maxValue,true);
+	if(index >= 0){
+		table[index].curve = &curve;
+		prepare(table[index]);
+	}
+	return index;
+}
+
+/*******************************************************************************
+Description: Scale an analog output channel. Written engineering values are
+			 converted back to counts and always kept inside the raw range.
+
+Parameters: -uint8_t slot - Slot of the module. Slots start at 1.
+			-uint8_t channel - Channel of the module. Channels start at 1.
+			-int32_t rawLow - Counts at engLow
+			-int32_t rawHigh - Counts at engHigh
+			-int32_t engLow - Engineering value at rawLow
+			-int32_t engHigh - Engineering value at rawHigh
+
+Returns: 	-int8_t - Index of the scaled channel. -1 on failure.
+
+Example Code: 
+*******************************************************************************/
+int8_t P1_Scaling::addOutput(uint8_t slot, uint8_t channel, int32_t engLow, int32_t engHigh){
+
+	return addChannel(slot,channel,true,0,moduleRange(slot),engLow,engHigh,true);
+
+}
+
+int8_t P1_Scaling::addOutput(uint8_t slot, uint8_t channel, int32_t rawLow, int32_t rawHigh, int32_t engLow, int32_t engHigh){
+
+	return addChannel(slot,channel,true,rawLow,rawHigh,engLow,engHigh,true);
+
+}
+
+/*******************************************************************************
+Description: Apply an offset and gain calibration to a scaled channel. The
+			 calibration is folded into the channel's fixed point factors so it
+			 costs nothing during the scan.
+
+Parameters: -uint8_t index - Index returned by addInput or addOutput
+			-float gain - Multiplier applied to the scaled value. 1.0 for none
+			-int32_t offset - Engineering units added after the gain
+
+Returns: 	-bool - true if the calibration was applied
+
+Example Code: 
+*******************************************************************************/
+bool P1_Scaling::calibrate(uint8_t index, float gain, int32_t offset){
+	float oldGain = 0;
+	int32_t oldOffset = 0;
+
+	if(index >= count){
+		debugPrintln("This channel is not valid");
+		return false;
+	}
+
+	oldGain = table[index].gain;
+	oldOffset = table[index].offset;
+	table[index].gain = gain;
+	table[index].offset = offset;
+	if(!prepare(table[index])){
+		table[index].gain = oldGain;
+		table[index].offset = oldOffset;
+		prepare(table[index]);
+		return false;
+	}
+	return true;
+}
+
+/*******************************************************************************
+Description: Convert the counts of every scaled input to engineering units.
+
+Parameters: -none
+
+Returns: 	-none
+
+Example Code: 
+*******************************************************************************/
+void P1_Scaling::update(void){
+	int32_t value = 0;
+	int32_t low = 0;
+	int32_t high = 0;
+
+	for(int i = 0; i < count; i++){
+		scaleChannel *entry = &table[i];
+		if(entry->output){
+			continue;
+		}
+
+		value = (int32_t)entry->image->inputValues[entry->index];
+		if(entry->curve != NULL){
+			value = entry->curve->evaluate(value);
+		}
+		value = (int32_t)(((int64_t)value * entry->mult + entry->bias + 0x8000) >> 16);
+		if(entry->clamp){
+			low = (entry->engLow < entry->engHigh) ? entry->engLow : entry->engHigh;
+			high = (entry->engLow < entry->engHigh) ? entry->engHigh : entry->engLow;
+			value = (value < low) ? low : ((value > high) ? high : value);
+		}
+		values[i] = value;
+	}
+}
+
+int32_t P1_Scaling::read(uint8_t index){
+
+	return (index < count) ? values[index] : 0;
+
+}
+
+uint8_t P1_Scaling::quality(uint8_t index){
+
+	if((index >= count) || table[index].output){
+		return QUALITY_NO_DATA;
+	}
+	return table[index].image->quality[table[index].index];
+}
+
+/*******************************************************************************
+Description: Convert an engineering value to counts and stage it in the scan's
+			 analog output image. Sent on the next scan.flush().
+
+Parameters: -uint8_t index - Index returned by addOutput
+			-int32_t value - Engineering value
+
+Returns: 	-none
+
+Example Code: 
+*******************************************************************************/
+void P1_Scaling::write(uint8_t index, int32_t value){
+	scaleChannel *entry;
+	int32_t raw = 0;
+	int32_t low = 0;
+	int32_t high = 0;
+
+	if((index >= count) || !table[index].output){
+		debugPrintln("This channel is not valid");
+		return;
+	}
+
+	entry = &table[index];
+	raw = (int32_t)(((int64_t)value * entry->invMult + entry->invBias + 0x8000) >> 16);
+	low = (entry->rawLow < entry->rawHigh) ? entry->rawLow : entry->rawHigh;
+	high = (entry->rawLow < entry->rawHigh) ? entry->rawHigh : entry->rawLow;
+	raw = (raw < low) ? low : ((raw > high) ? high : raw);
+
+	values[index] = value;
+	entry->image->outputValues[entry->index] = (uint32_t)raw;
+	entry->image->outputsChanged = true;
+}
+
+int8_t P1_Scaling::addChannel(uint8_t slot, uint8_t channel, bool output, int32_t rawLow, int32_t rawHigh, int32_t engLow, int32_t engHigh, bool clamp){
+	slotImage *image = NULL;
+	scaleChannel *entry;
+	uint8_t channels = 0;
+
+	if(count >= SCALE_CHANNELS){
+		debugPrintln("No room for another scaled channel");
+		return -1;
+	}
+	if(!scan->analogChannel(slot,channel).valid()){
+		return -1;
+	}
+
+	image = scan->getSlot(slot);
+	channels = (output ? image->props.aoBytes : image->props.aiBytes) / 4;
+	if(channel > channels){
+		debugPrintln("This channel is not valid");
+		return -1;
+	}
+
+	entry = &table[count];
+	entry->image = image;
+	entry->index = channel - 1;
+	entry->output = output;
+	entry->clamp = clamp;
+	entry->rawLow = rawLow;
+	entry->rawHigh = rawHigh;
+	entry->engLow = engLow;
+	entry->engHigh = engHigh;
+	entry->gain = 1.0f;
+	entry->offset = 0;
+	entry->curve = NULL;
+	if(!prepare(*entry)){
+		return -1;
+	}
+	return count++;
+}
+
+bool P1_Scaling::prepare(scaleChannel &entry){
+	double slope = 0;
+	double intercept = 0;
+	double mult = 0;
+	double invMult = 0;
+
+	if((entry.rawHigh == entry.rawLow) || (entry.gain == 0)){
+		debugPrintln("Scaling range is not valid");
+		return false;
+	}
+
+	if(entry.curve != NULL){		//Table gives engineering units. Only the calibration is left
+		entry.mult = (int32_t)floor(entry.gain * 65536.0 + 0.5);
+		entry.bias = (int64_t)entry.offset * 65536;
+		return true;
+	}
+
+	slope = ((double)entry.engHigh - entry.engLow) / ((double)entry.rawHigh - entry.rawLow) * entry.gain;
+	intercept = (entry.engLow - (entry.rawLow * ((double)entry.engHigh - entry.engLow) / ((double)entry.rawHigh - entry.rawLow))) * entry.gain + entry.offset;
+	mult = slope * 65536;
+	invMult = 65536 / slope;
+	if((mult >= 2147483648.0) || (mult <= -2147483648.0) || (invMult >= 2147483648.0) || (invMult <= -2147483648.0)){
+		debugPrintln("Scaling range is not valid");
+		return false;
+	}
+
+	entry.mult = (int32_t)floor(mult + 0.5);
+	entry.bias = (int64_t)floor(intercept * 65536 + 0.5);
+	entry.invMult = (int32_t)floor(invMult + 0.5);
+	entry.invBias = (int64_t)floor(-intercept / slope * 65536 + 0.5);
+	return true;
+}
+
+int32_t P1_Scaling::moduleRange(uint8_t slot){
+	uint8_t bits = P1.readSlotProps(slot).dataSize;
+
+	if((bits == 0) || (bits > 24)){
+		return 0;		//Not a counts based module
+	}
+	return (1L << bits) - 1;
+}
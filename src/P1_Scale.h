@@ -0,0 +1,79 @@
+/*
+MIT License
+
+Copyright (c) 2023 FACTS Engineering, LLC
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef P1_Scale_h
+#define P1_Scale_h
+
+#include "P1AM.h"
+#include "P1_Scan.h"
+#include "P1_Linearize.h"
+
+#define SCALE_CHANNELS 16		//Maximum number of scaled channels per scaling engine
+
+class P1_Scaling{
+
+	public:
+	P1_Scaling(P1_Scan &scan);
+
+	//Setup - Returns the index of the scaled channel or -1 on failure. Call after scan.begin()
+	int8_t addInput(uint8_t slot, uint8_t channel, int32_t engLow, int32_t engHigh, bool clamp = true);	//Raw range from the module resolution
+	int8_t addInput(uint8_t slot, uint8_t channel, int32_t rawLow, int32_t rawHigh, int32_t engLow, int32_t engHigh, bool clamp = true);
+	int8_t addInput(uint8_t slot, uint8_t channel, const P1_Linearization &curve);	//Non-linear sensor. Table values are engineering units
+	int8_t addOutput(uint8_t slot, uint8_t channel, int32_t engLow, int32_t engHigh);
+	int8_t addOutput(uint8_t slot, uint8_t channel, int32_t rawLow, int32_t rawHigh, int32_t engLow, int32_t engHigh);
+	bool calibrate(uint8_t index, float gain, int32_t offset);	//engineering = scaled * gain + offset
+
+	//Scan Functions
+	void update(void);				//Scale every input channel. Call after scan.update()
+	int32_t read(uint8_t index);	//Engineering value from the last update
+	uint8_t quality(uint8_t index);	//Quality flags of the raw value
+	void write(uint8_t index, int32_t value);	//Convert to counts and stage in the scan. Sent on scan.flush()
+	int32_t values[SCALE_CHANNELS];	//Engineering values of every channel from the last update
+
+	private:
+	struct scaleChannel{
+		slotImage *image;
+		uint8_t index;				//Register in the slot image
+		bool output;
+		bool clamp;
+		int32_t rawLow;
+		int32_t rawHigh;
+		int32_t engLow;
+		int32_t engHigh;
+		float gain;
+		int32_t offset;
+		const P1_Linearization *curve;	//NULL for a straight line
+		int32_t mult;				//Q16 counts to engineering units
+		int64_t bias;				//Q16
+		int32_t invMult;			//Q16 engineering units to counts
+		int64_t invBias;			//Q16
+	}table[SCALE_CHANNELS];
+	P1_Scan *scan;
+	uint8_t count = 0;
+	int8_t addChannel(uint8_t slot, uint8_t channel, bool output, int32_t rawLow, int32_t rawHigh, int32_t engLow, int32_t engHigh, bool clamp);
+	bool prepare(scaleChannel &entry);
+	int32_t moduleRange(uint8_t slot);
+};
+
+#endif
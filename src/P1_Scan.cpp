@@ -0,0 +1,540 @@
+/*
+MIT License
+
+Copyright (c) 2023 FACTS Engineering, LLC
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include "P1_Scan.h"
+
+/*******************************************************************************
+Description: Typed channel handles. Each one points into the slot image of a
+			 P1_Scan and is only valid for the driver family it was made for.
+			 Reads return the values decoded by the last update and writes are
+			 sent by the next flush.
+*******************************************************************************/
+P1_DiscreteChannel::P1_DiscreteChannel(slotImage *image, uint8_t channel){
+
+	this->image = image;
+	mask = (channel > 0) ? (1 << (channel - 1)) : 0;
+
+}
+
+bool P1_DiscreteChannel::valid(void){
+
+	return image != NULL;
+
+}
+
+bool P1_DiscreteChannel::read(void){
+
+	return (image != NULL) && (image->inputs & mask);
+
+}
+
+bool P1_DiscreteChannel::readOutput(void){
+
+	return (image != NULL) && (image->outputs & mask);
+
+}
+
+void P1_DiscreteChannel::write(bool state){
+
+	if(image == NULL){
+		return;
+	}
+	if(state){
+		image->outputs |= mask;
+	}
+	else{
+		image->outputs &= ~mask;
+	}
+	image->outputsChanged = true;
+}
+
+P1_AnalogChannel::P1_AnalogChannel(slotImage *image, uint8_t channel){
+
+	this->image = image;
+	index = (channel > 0) ? channel - 1 : 0;
+
+}
+
+bool P1_AnalogChannel::valid(void){
+
+	return image != NULL;
+
+}
+
+int P1_AnalogChannel::read(void){
+
+	return (image != NULL) ? (int)image->inputValues[index] : 0;
+
+}
+
+uint8_t P1_AnalogChannel::quality(void){
+
+	return (image != NULL) ? image->quality[index] : QUALITY_NO_DATA;
+
+}
+
+void P1_AnalogChannel::write(uint32_t counts){
+
+	if(image == NULL){
+		return;
+	}
+	image->outputValues[index] = counts;
+	image->outputsChanged = true;
+}
+
+P1_TemperatureChannel::P1_TemperatureChannel(slotImage *image, uint8_t channel){
+
+	this->image = image;
+	index = (channel > 0) ? channel - 1 : 0;
+
+}
+
+bool P1_TemperatureChannel::valid(void){
+
+	return image != NULL;
+
+}
+
+float P1_TemperatureChannel::read(void){
+	union int2float{
+		uint32_t data;
+		float temperature;
+	}ourValue;
+
+	if((image == NULL) || (image->quality[index] != QUALITY_GOOD)){
+		return NAN;
+	}
+	ourValue.data = image->inputValues[index];
+	return ourValue.temperature;
+}
+
+uint8_t P1_TemperatureChannel::quality(void){
+
+	return (image != NULL) ? image->quality[index] : QUALITY_NO_DATA;
+
+}
+
+P1_PWMChannel::P1_PWMChannel(slotImage *image, uint8_t channel){
+
+	this->image = image;
+	index = (channel > 0) ? (channel - 1) * 2 : 0;	//Duty then frequency register per channel
+
+}
+
+bool P1_PWMChannel::valid(void){
+
+	return image != NULL;
+
+}
+
+void P1_PWMChannel::write(uint16_t duty, uint32_t freq){
+
+	writeDuty(duty);
+	writeFreq(freq);
+
+}
+
+void P1_PWMChannel::writeDuty(uint16_t duty){
+
+	if(image == NULL){
+		return;
+	}
+	image->outputValues[index] = duty;
+	image->outputsChanged = true;
+}
+
+void P1_PWMChannel::writeFreq(uint32_t freq){
+
+	if(image == NULL){
+		return;
+	}
+	image->outputValues[index + 1] = freq;
+	image->outputsChanged = true;
+}
+
+P1_CounterChannel::P1_CounterChannel(slotImage *image, uint8_t channel){
+
+	this->image = image;
+	index = (channel > 0) ? channel - 1 : 0;
+
+}
+
+bool P1_CounterChannel::valid(void){
+
+	return image != NULL;
+
+}
+
+int P1_CounterChannel::readPosition(void){
+
+	return (image != NULL) ? (int)image->inputValues[index] : 0;	//Registers 1 and 2
+
+}
+
+uint32_t P1_CounterChannel::readAlerts(void){
+
+	return (image != NULL) ? image->inputValues[index + 3] : 0;		//Registers 4 and 5
+
+}
+
+/*******************************************************************************
+Description: Constructor for P1_Scan class. The scan gives each slot a driver
+			 for its module family when the base signs on. Every update reads
+			 the inputs of the whole base in one snapshot and each driver
+			 decodes its own slot, so reads through the channel handles need no
+			 bus traffic or module checks.
+
+Parameters: -none
+
+Returns: 	-none
+
+Example Code: 
+*******************************************************************************/
+P1_Scan::P1_Scan(){
+
+	memset(slots,0,sizeof(slots));
+	memset(overrides,0,sizeof(overrides));
+
+}
+
+/*******************************************************************************
+Description: Use a different driver for a module ID. Must be called before begin.
+
+Parameters: -uint32_t moduleID - Module ID from Module_List.h
+			-const P1_Driver *driver - Driver to use for that module
+
+Returns: 	-bool - true if the driver was registered
+
+Example Code: 
+*******************************************************************************/
+bool P1_Scan::registerDriver(uint32_t moduleID, const P1_Driver *driver){
+
+	for(int i = 0; i < overrideCount; i++){
+		if(overrides[i].moduleID == moduleID){
+			overrides[i].driver = driver;
+			return true;
+		}
+	}
+	if(overrideCount >= SCAN_DRIVER_OVERRIDES){
+		debugPrintln("No room for another driver");
+		return false;
+	}
+	overrides[overrideCount].moduleID = moduleID;
+	overrides[overrideCount].driver = driver;
+	overrideCount++;
+	return true;
+}
+
+/*******************************************************************************
+Description: Take the driver every module was given at sign-on, or the one
+			 registered for it, and the offsets of its data in each block. The current outputs are read back so the first
+			 flush does not change any outputs.
+
+Parameters: -none
+
+Returns: 	-none
+
+Example Code: 
+*******************************************************************************/
+void P1_Scan::begin(void){
+	uint16_t doBytes = 0;
+	uint16_t aoBytes = 0;
+	slotImage *image;
+
+	memset(slots,0,sizeof(slots));
+	slotCount = 0;
+	diBytes = 0;
+	aiBytes = 0;
+	statusBytes = 0;
+
+	for(int i = 0; i < NUMBER_OF_MODULES; i++){
+		image = &slots[i];
+		image->slot = i + 1;
+		image->props = P1.readSlotProps(i + 1);
+		if(image->props.moduleID == 0){
+			break;		//Modules are contiguous
+		}
+		image->driver = findDriver(i + 1,image->props);
+		image->diOffset = diBytes;
+		image->doOffset = doBytes;
+		image->aiOffset = aiBytes;
+		image->aoOffset = aoBytes;
+		image->statusOffset = statusBytes;
+		diBytes += image->props.diBytes;
+		doBytes += image->props.doBytes;
+		aiBytes += image->props.aiBytes;
+		aoBytes += image->props.aoBytes;
+		statusBytes += image->props.statusBytes;
+		slotCount++;
+	}
+
+	if(doBytes > 0){
+		P1.readBlockData((char *)blockBuffer,doBytes,0,DISCRETE_OUT_BLOCK);
+		for(int i = 0; i < slotCount; i++){
+			image = &slots[i];
+			for(int j = 0; j < image->props.doBytes; j++){
+				image->outputs |= (uint16_t)blockBuffer[image->doOffset + j] << (8 * j);
+			}
+		}
+	}
+	if(aoBytes > 0){
+		P1.readBlockData((char *)blockBuffer,aoBytes,0,ANALOG_OUT_BLOCK);
+		for(int i = 0; i < slotCount; i++){
+			image = &slots[i];
+			decodeAnalogBlock(blockBuffer + image->aoOffset,(int32_t *)image->outputValues,image->props.aoBytes / 4);
+		}
+	}
+}
+
+/*******************************************************************************
+Description: Read the discrete, analog and status inputs of the whole base in
+			 one snapshot and let each slot's driver decode its data. If the
+			 snapshot fails the last values are kept and every analog channel
+			 is flagged QUALITY_NO_DATA.
+
+Parameters: -none
+
+Returns: 	-uint32_t - Scan sequence number of the inputs. 0 if the read failed.
+
+Example Code: 
+*******************************************************************************/
+uint32_t P1_Scan::update(void){
+	uint8_t *di = blockBuffer;
+	uint8_t *ai = blockBuffer + SCAN_DISCRETE_BYTES;
+	uint8_t *status = ai + SCAN_ANALOG_BYTES;
+	blockRegion regions[3];
+	uint8_t count = 0;
+	uint32_t sequence = 0;
+
+	if(diBytes > 0){
+		regions[count++] = {(char *)di, diBytes, 0, DISCRETE_IN_BLOCK};
+	}
+	if(aiBytes > 0){
+		regions[count++] = {(char *)ai, aiBytes, 0, ANALOG_IN_BLOCK};
+	}
+	if(statusBytes > 0){
+		regions[count++] = {(char *)status, statusBytes, 0, STATUS_IN_BLOCK};
+	}
+
+	if(count == 0){
+		return P1.getScanSequence();
+	}
+	sequence = P1.readBlockSnapshot(regions,count);
+
+	for(int i = 0; i < slotCount; i++){
+		slotImage *image = &slots[i];
+		if(sequence == 0){
+			for(int j = 0; j < SCAN_CHANNELS; j++){
+				image->quality[j] |= QUALITY_NO_DATA;
+			}
+		}
+		else if(image->driver != NULL){
+			image->driver->decode(*image, di + image->diOffset, ai + image->aiOffset, status + image->statusOffset);
+		}
+	}
+
+	if(sequence != 0){
+		scanSequence = sequence;
+		timestamp = P1.getScanTimestamp();
+	}
+	return sequence;
+}
+
+/*******************************************************************************
+Description: Check if this scan holds a scan the caller has not used yet. Classes
+			 that work from the scan keep the sequence number of the last scan
+			 they used and call this at the top of their update. Each scan is
+			 used once, so calling their update more often than scan.update
+			 does nothing, and nothing is used before the first good update.
+
+Parameters: -uint32_t &lastSequence - Sequence number of the last scan the caller
+			 used. Set to the current scan when it is new.
+
+Returns: 	-bool - true if the scan is new
+*******************************************************************************/
+bool P1_Scan::isNewScan(uint32_t &lastSequence) const{
+
+	if(scanSequence == lastSequence){
+		return false;		//Already have this scan
+	}
+	lastSequence = scanSequence;
+	return true;
+
+}
+
+/*******************************************************************************
+Description: Encode the outputs of every slot written since the last flush.
+			 Changed slots that sit next to each other in a block are sent in
+			 the same block write.
+
+Parameters: -none
+
+Returns: 	-uint8_t - Number of block writes sent
+
+Example Code: 
+*******************************************************************************/
+uint8_t P1_Scan::flush(void){
+	uint8_t writes = 0;
+
+	writes += writeRuns(DISCRETE_OUT_BLOCK);
+	writes += writeRuns(ANALOG_OUT_BLOCK);
+	for(int i = 0; i < slotCount; i++){
+		slots[i].outputsChanged = false;
+	}
+	return writes;
+}
+
+uint8_t P1_Scan::writeRuns(uint8_t type){
+	uint16_t runStart = 0;
+	uint16_t runLen = 0;
+	uint16_t offset = 0;
+	uint8_t len = 0;
+	uint8_t writes = 0;
+
+	for(int i = 0; i < slotCount; i++){
+		slotImage *image = &slots[i];
+		if(!image->outputsChanged || (image->driver == NULL)){
+			continue;
+		}
+
+		offset = (type == DISCRETE_OUT_BLOCK) ? image->doOffset : image->aoOffset;
+		if((runLen > 0) && (offset != runStart + runLen)){
+			P1.writeBlockData((char *)blockBuffer,runLen,runStart,type);	//Gap in the run. Send what we have
+			writes++;
+			runLen = 0;
+		}
+
+		len = image->driver->encode(*image, type, blockBuffer + runLen);
+		if(len > 0){
+			if(runLen == 0){
+				runStart = offset;
+			}
+			runLen += len;
+		}
+	}
+
+	if(runLen > 0){
+		P1.writeBlockData((char *)blockBuffer,runLen,runStart,type);
+		writes++;
+	}
+	return writes;
+}
+
+/*******************************************************************************
+Description: Get the typed channel handle of a slot. The handle is invalid if
+			 the slot's driver is not of that family or the channel does not
+			 exist. Check it with valid().
+
+Parameters: -uint8_t slot - Slot of the module. Slots start at 1.
+			-uint8_t channel - Channel of the module. Channels start at 1.
+
+Returns: 	-Channel handle
+
+Example Code: 
+*******************************************************************************/
+slotImage *P1_Scan::getSlot(uint8_t slot){
+
+	if((slot < 1) || (slot > slotCount)){
+		return NULL;
+	}
+	return &slots[slot-1];
+
+}
+
+P1_DiscreteChannel P1_Scan::discreteChannel(uint8_t slot, uint8_t channel){
+	slotImage *image = getSlot(slot);
+	uint8_t channels = 0;
+
+	if(image != NULL){
+		channels = ((image->props.diBytes > image->props.doBytes) ? image->props.diBytes : image->props.doBytes) * 8;
+	}
+	return P1_DiscreteChannel(checkSlot(slot,channel,DRIVER_DISCRETE,channels),channel);
+}
+
+P1_AnalogChannel P1_Scan::analogChannel(uint8_t slot, uint8_t channel){
+	slotImage *image = getSlot(slot);
+	uint8_t channels = 0;
+
+	if(image != NULL){
+		channels = ((image->props.aiBytes > image->props.aoBytes) ? image->props.aiBytes : image->props.aoBytes) / 4;
+	}
+	return P1_AnalogChannel(checkSlot(slot,channel,DRIVER_ANALOG,channels),channel);
+}
+
+P1_TemperatureChannel P1_Scan::temperatureChannel(uint8_t slot, uint8_t channel){
+	slotImage *image = getSlot(slot);
+	uint8_t channels = 0;
+
+	if(image != NULL){
+		channels = image->props.aiBytes / 4;
+	}
+	return P1_TemperatureChannel(checkSlot(slot,channel,DRIVER_TEMPERATURE,channels),channel);
+}
+
+P1_PWMChannel P1_Scan::pwmChannel(uint8_t slot, uint8_t channel){
+	slotImage *image = getSlot(slot);
+	uint8_t channels = 0;
+
+	if(image != NULL){
+		channels = image->props.aoBytes / 8;	//Duty and frequency per channel
+	}
+	return P1_PWMChannel(checkSlot(slot,channel,DRIVER_PWM,channels),channel);
+}
+
+P1_CounterChannel P1_Scan::counterChannel(uint8_t slot, uint8_t channel){
+
+	return P1_CounterChannel(checkSlot(slot,channel,DRIVER_HSC,2),channel);
+
+}
+
+slotImage *P1_Scan::checkSlot(uint8_t slot, uint8_t channel, uint8_t family, uint8_t channels){
+	slotImage *image = getSlot(slot);
+
+	if(image == NULL){
+		debugPrint("Slots must be between 1 and ");
+		debugPrintln(slotCount);
+		return NULL;
+	}
+	if((image->driver == NULL) || (image->driver->family() != family)){
+		debugPrint("Slot ");
+		debugPrint(slot);
+		debugPrintln(": This module does not use this driver");
+		return NULL;
+	}
+	if((channel <= 0) || (channel > channels)){
+		debugPrintln("This channel is not valid");
+		return NULL;
+	}
+	return image;
+}
+
+const P1_Driver *P1_Scan::findDriver(uint8_t slot, const moduleProps &props){
+
+	for(int i = 0; i < overrideCount; i++){
+		if(overrides[i].moduleID == props.moduleID){
+			return overrides[i].driver;
+		}
+	}
+	return P1.readSlotDriver(slot);		//Driver resolved at sign-on
+}
@@ -0,0 +1,134 @@
+/*
+MIT License
+
+Copyright (c) 2023 FACTS Engineering, LLC
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef P1_Scan_h
+#define P1_Scan_h
+
+#include "P1AM.h"
+
+#define SCAN_DISCRETE_BYTES		(NUMBER_OF_MODULES * 2)
+#define SCAN_ANALOG_BYTES		(NUMBER_OF_MODULES * SCAN_CHANNELS * 4)
+#define SCAN_STATUS_BYTES		(NUMBER_OF_MODULES * 12)
+#define SCAN_DRIVER_OVERRIDES	4								//Drivers that can be added with registerDriver
+
+class P1_DiscreteChannel{
+	public:
+	P1_DiscreteChannel(slotImage *image = NULL, uint8_t channel = 0);
+	bool valid(void);
+	bool read(void);				//Input state from the last update
+	bool readOutput(void);
+	void write(bool state);			//Sent on the next flush
+	private:
+	slotImage *image;
+	uint16_t mask;
+};
+
+class P1_AnalogChannel{
+	public:
+	P1_AnalogChannel(slotImage *image = NULL, uint8_t channel = 0);
+	bool valid(void);
+	int read(void);					//Counts from the last update
+	uint8_t quality(void);
+	void write(uint32_t counts);	//Sent on the next flush
+	private:
+	slotImage *image;
+	uint8_t index;
+};
+
+class P1_TemperatureChannel{
+	public:
+	P1_TemperatureChannel(slotImage *image = NULL, uint8_t channel = 0);
+	bool valid(void);
+	float read(void);				//NAN if the channel is not QUALITY_GOOD
+	uint8_t quality(void);
+	private:
+	slotImage *image;
+	uint8_t index;
+};
+
+class P1_PWMChannel{
+	public:
+	P1_PWMChannel(slotImage *image = NULL, uint8_t channel = 0);
+	bool valid(void);
+	void write(uint16_t duty, uint32_t freq);	//Duty in hundredths of a percent. Sent on the next flush
+	void writeDuty(uint16_t duty);
+	void writeFreq(uint32_t freq);
+	private:
+	slotImage *image;
+	uint8_t index;
+};
+
+class P1_CounterChannel{
+	public:
+	P1_CounterChannel(slotImage *image = NULL, uint8_t channel = 0);
+	bool valid(void);
+	int readPosition(void);			//Position from the last update
+	uint32_t readAlerts(void);
+	private:
+	slotImage *image;
+	uint8_t index;
+};
+
+class P1_Scan{
+
+	public:
+	P1_Scan();
+
+	//Setup
+	bool registerDriver(uint32_t moduleID, const P1_Driver *driver);	//Use a different driver for a module. Call before begin
+	void begin(void);				//Resolve the driver of every slot. Call after P1.init()
+
+	//Scan Functions
+	uint32_t update(void);			//Read all inputs in one snapshot and decode every slot. Returns scan sequence number
+	uint8_t flush(void);			//Encode changed slots and write them. Returns number of block writes
+	uint32_t scanSequence = 0;		//Sequence number of the last good update
+	uint32_t timestamp = 0;			//micros() at the end of the scan of the last good update
+	bool isNewScan(uint32_t &lastSequence) const;	//True once per scan for each caller. Used by update() of scan-fed classes
+
+	//Channel Functions - Return an invalid channel if the slot does not use that driver family
+	slotImage *getSlot(uint8_t slot);
+	P1_DiscreteChannel discreteChannel(uint8_t slot, uint8_t channel);
+	P1_AnalogChannel analogChannel(uint8_t slot, uint8_t channel);
+	P1_TemperatureChannel temperatureChannel(uint8_t slot, uint8_t channel);
+	P1_PWMChannel pwmChannel(uint8_t slot, uint8_t channel);
+	P1_CounterChannel counterChannel(uint8_t slot, uint8_t channel);
+
+	private:
+	slotImage slots[NUMBER_OF_MODULES];
+	uint8_t slotCount = 0;
+	uint16_t diBytes = 0;
+	uint16_t aiBytes = 0;
+	uint16_t statusBytes = 0;
+	uint8_t blockBuffer[SCAN_DISCRETE_BYTES + SCAN_ANALOG_BYTES + SCAN_STATUS_BYTES];
+	struct driverOverride{
+		uint32_t moduleID;
+		const P1_Driver *driver;
+	}overrides[SCAN_DRIVER_OVERRIDES];
+	uint8_t overrideCount = 0;
+	const P1_Driver *findDriver(uint8_t slot, const moduleProps &props);
+	slotImage *checkSlot(uint8_t slot, uint8_t channel, uint8_t family, uint8_t channels);
+	uint8_t writeRuns(uint8_t type);
+};
+
+#endif
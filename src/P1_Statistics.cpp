@@ -0,0 +1,200 @@
+/*
+MIT License
+
+Copyright (c) 2023 FACTS Engineering, LLC
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include "P1_Statistics.h"
+
+/*******************************************************************************
+Description: Constructor for P1_Statistics class. Keeps the count, min, max,
+			 mean and variance of analog and temperature channels of a P1_Scan.
+			 Welford's method updates the mean and variance one sample at a time
+			 with a fixed amount of work. The running mean and sum of squares
+			 are kept in double, so a window of millions of samples still moves
+			 the mean where a float would stop changing. Reading the
+			 statistics causes no bus traffic.
+
+Parameters: -P1_Scan &scan - Scan holding the analog image
+
+Returns: 	-none
+
+Example Code: 
+*******************************************************************************/
+P1_Statistics::P1_Statistics(P1_Scan &scan){
+
+	this->scan = &scan;
+	memset(table,0,sizeof(table));
+
+}
+
+/*******************************************************************************
+Description: Keep statistics for an analog or temperature input channel.
+
+Parameters: -uint8_t slot - Slot of the module. Slots start at 1.
+			-uint8_t channel - Channel of the module. Channels start at 1.
+			-uint32_t windowSamples - Samples per window. When a window fills it
+			 is saved for readWindow and a new one starts. 0 for one window
+			 that only ends with reset.
+
+Returns: 	-int8_t - Index of the channel. -1 on failure.
+
+Example Code: 
+*******************************************************************************/
+int8_t P1_Statistics::addChannel(uint8_t slot, uint8_t channel, uint32_t windowSamples){
+	slotImage *image = NULL;
+	bool temperature = false;
+
+	if(count >= STATISTICS_CHANNELS){
+		debugPrintln("No room for another channel");
+		return -1;
+	}
+
+	image = scan->getSlot(slot);
+	temperature = (image != NULL) && (image->driver != NULL) && (image->driver->family() == DRIVER_TEMPERATURE);
+	if(temperature ? !scan->temperatureChannel(slot,channel).valid() : !scan->analogChannel(slot,channel).valid()){
+		return -1;
+	}
+	if(channel > (image->props.aiBytes / 4)){
+		debugPrintln("This channel is not valid");
+		return -1;
+	}
+
+	table[count].image = image;
+	table[count].index = channel - 1;
+	table[count].temperature = temperature;
+	table[count].windowSamples = windowSamples;		//Statistics start at 0 from the constructor
+	return count++;
+}
+
+/*******************************************************************************
+Description: End the current window. Its statistics are saved for readWindow and
+			 a new window starts with the next sample.
+
+Parameters: -uint8_t index - Index returned by addChannel
+
+Returns: 	-none
+
+Example Code: 
+*******************************************************************************/
+void P1_Statistics::reset(uint8_t index){
+
+	if(index >= count){
+		return;
+	}
+	if(table[index].current.samples > 0){
+		finish(table[index]);
+	}
+	memset(&table[index].current,0,sizeof(channelStats));
+	table[index].mean = 0;
+	table[index].m2 = 0;
+}
+
+/*******************************************************************************
+Description: Add the latest scan to every channel. Samples that are not
+			 QUALITY_GOOD are left out.
+
+Parameters: -none
+
+Returns: 	-none
+
+Example Code: 
+*******************************************************************************/
+void P1_Statistics::update(void){
+	statsChannel *channel;
+	channelStats *stats;
+	union int2float{
+		uint32_t data;
+		float value;
+	}sample;
+	double delta = 0;
+
+	if(!scan->isNewScan(lastSequence)){
+		return;
+	}
+
+	for(int i = 0; i < count; i++){
+		channel = &table[i];
+		stats = &channel->current;
+		if(channel->image->quality[channel->index] != QUALITY_GOOD){
+			continue;
+		}
+
+		sample.data = channel->image->inputValues[channel->index];
+		if(!channel->temperature){
+			sample.value = (float)(int32_t)sample.data;		//Counts
+		}
+
+		stats->samples++;
+		if((stats->samples == 1) || (sample.value < stats->min)){
+			stats->min = sample.value;
+		}
+		if((stats->samples == 1) || (sample.value > stats->max)){
+			stats->max = sample.value;
+		}
+		delta = sample.value - channel->mean;		//Welford
+		channel->mean += delta / stats->samples;
+		channel->m2 += delta * (sample.value - channel->mean);
+		stats->mean = (float)channel->mean;
+		stats->variance = (stats->samples > 1) ? (float)(channel->m2 / (stats->samples - 1)) : 0;
+
+		if((channel->windowSamples > 0) && (stats->samples >= channel->windowSamples)){
+			reset(i);
+		}
+	}
+}
+
+channelStats P1_Statistics::read(uint8_t index){
+	channelStats empty;
+
+	if(index >= count){
+		memset(&empty,0,sizeof(empty));
+		return empty;
+	}
+	return table[index].current;
+}
+
+channelStats P1_Statistics::readWindow(uint8_t index){
+	channelStats empty;
+
+	if(index >= count){
+		memset(&empty,0,sizeof(empty));
+		return empty;
+	}
+	return table[index].last;
+}
+
+bool P1_Statistics::windowDone(uint8_t index){
+	bool done = false;
+
+	if(index < count){
+		done = table[index].done;
+		table[index].done = false;
+	}
+	return done;
+}
+
+void P1_Statistics::finish(statsChannel &channel){
+
+	channel.last = channel.current;
+	channel.done = true;
+
+}
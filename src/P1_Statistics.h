@@ -0,0 +1,74 @@
+/*
+MIT License
+
+Copyright (c) 2023 FACTS Engineering, LLC
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef P1_Statistics_h
+#define P1_Statistics_h
+
+#include "P1AM.h"
+#include "P1_Scan.h"
+
+#define STATISTICS_CHANNELS 8		//Maximum number of channels per statistics bank
+
+struct channelStats{			//Statistics of one channel over a window of scans
+	uint32_t samples;			//Good samples in the window
+	float min;
+	float max;
+	float mean;
+	float variance;				//Sample variance. 0 until there are 2 samples
+};
+
+class P1_Statistics{
+
+	public:
+	P1_Statistics(P1_Scan &scan);
+
+	//Setup - Returns the index of the channel or -1 on failure. Call after scan.begin()
+	int8_t addChannel(uint8_t slot, uint8_t channel, uint32_t windowSamples = 0);	//Analog or temperature channel. 0 never ends the window
+	void reset(uint8_t index);		//Start a new window now
+
+	//Scan Functions
+	void update(void);				//Add the latest scan to every channel. Call after scan.update()
+	channelStats read(uint8_t index);			//Window in progress
+	channelStats readWindow(uint8_t index);		//Last completed window
+	bool windowDone(uint8_t index);				//true once per completed window
+
+	private:
+	struct statsChannel{
+		slotImage *image;
+		uint8_t index;				//Register in the slot image
+		bool temperature;
+		bool done;
+		uint32_t windowSamples;
+		double mean;				//Running mean. double so small steps are not lost in long windows
+		double m2;					//Sum of squared differences from the mean
+		channelStats current;
+		channelStats last;
+	}table[STATISTICS_CHANNELS];
+	P1_Scan *scan;
+	uint8_t count = 0;
+	uint32_t lastSequence = 0;
+	void finish(statsChannel &channel);
+};
+
+#endif
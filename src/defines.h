@@ -82,11 +82,24 @@ SOFTWARE.
 #define ANALOG_OUT_BLOCK	3
 #define STATUS_IN_BLOCK		4
 
+#define SYNC_STRICT			0		//Wait a full scan after every read and write
+#define SYNC_DEFERRED		1		//Sync writes once before the next read or on sync()
+#define SYNC_NONE			2		//Never wait on the Base Controller scan
+
+#define SNAPSHOT_RETRIES	3		//Attempts readBlockSnapshot makes before giving up on a coherent read
+
 #define MISSING24V_STATUS 	3
 #define BURNOUT_STATUS		5
 #define UNDER_RANGE_STATUS	7
 #define OVER_RANGE_STATUS	11
 
+#define QUALITY_GOOD		0x00	//Quality flags returned in channelReading
+#define QUALITY_BURNOUT		0x01
+#define QUALITY_UNDER_RANGE	0x02
+#define QUALITY_OVER_RANGE	0x04
+#define QUALITY_MISSING_24V	0x08
+#define QUALITY_NO_DATA		0x80	//Snapshot failed, value is not valid
+
 #define TOGGLE				0x01
 #define HOLD				0x00
 